@@ -1,6 +1,9 @@
 
 #include "OhmCat.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace{
 const double HANKY_SIZE = 0.40;
 }
@@ -15,6 +18,7 @@ OhmCat::OhmCat() : _rate(0)
     std::string pub_vel;
     std::string pub_event;
     std::string sub_vel;
+    std::string sub_imu;
     std::string srv_slam_ctrl;
     std::string robot_foot_print;
     std::string robot_link;
@@ -26,6 +30,9 @@ OhmCat::OhmCat() : _rate(0)
     double time_move;
     double time_next_move;
     double fix_move_vel;
+    double imu_timeout;
+    int predict_samples;
+    double predict_stats_period;
     //int int_val;
 
     privNh.param("pub_vel",                 pub_vel,         std::string("vel/teleop"));
@@ -42,6 +49,13 @@ OhmCat::OhmCat() : _rate(0)
     privNh.param<double>("time_move",       time_move,       1.0);
     privNh.param<double>("time_next_move",  time_next_move,  5.0);
     privNh.param<double>("fix_move_vel",    fix_move_vel,    0.2);
+    privNh.param<bool>("imu_mode",          _imu_mode,       false);
+    privNh.param("sub_imu",                 sub_imu,         std::string("imu/data"));
+    privNh.param<double>("imu_timeout",     imu_timeout,     0.1);
+    privNh.param<double>("imu_filter_gain", _imu_filter_gain, 0.98);
+    privNh.param<double>("predict_horizon", _predict_horizon, 0.0);
+    privNh.param<int>("predict_samples",    predict_samples, 16);
+    privNh.param<double>("predict_stats_period", predict_stats_period, 10.0);
 
     _robot_foot_print = robot_foot_print;
     _robot_link = robot_link;
@@ -53,6 +67,9 @@ OhmCat::OhmCat() : _rate(0)
     _duration_move = ros::Duration(time_move);
     _duration_next_move = ros::Duration(time_next_move);
     _fix_move_vel = fix_move_vel;
+    _imu_timeout = ros::Duration(imu_timeout);
+    _predictor.setSize(std::max(predict_samples, 3));
+    _predict_stats_period = ros::WallDuration(predict_stats_period);
 
     //init publisher
     _pubVel   = _nh.advertise<geometry_msgs::Twist>(pub_vel,1);
@@ -61,6 +78,9 @@ OhmCat::OhmCat() : _rate(0)
 
     //inti subscriber
     _subVel = _nh.subscribe(sub_vel, 1, &OhmCat::subVel_callback, this);
+    //imu runs at 100-400 Hz, every sample drives the state machine
+    if(_imu_mode)
+       _subImu = _nh.subscribe(sub_imu, 10, &OhmCat::subImu_callback, this, ros::TransportHints().tcpNoDelay());
 
     //init service
     _srv_slam = _nh.serviceClient<ohm_apps_msgs::NodeControl>(srv_slam_ctrl);
@@ -73,10 +93,23 @@ OhmCat::OhmCat() : _rate(0)
 
     _cnt = 0;
 
+    _imu_init = false;
+    _pitch = 0;
+    _roll = 0;
+
+    _predict_stats_last = ros::WallTime::now();
+    _predict_runs = 0;
+    _predict_cost_sum = 0;
+    _predict_cost_max = 0;
+    _predict_ttl_min = std::numeric_limits<double>::infinity();
+    _predict_triggers = 0;
+    _predict_triggers_total = 0;
+
     //init times:
     _time_last_ok = ros::Time::now();
     _time_last_notOk = ros::Time::now();
     _time_last_move = ros::Time::now();
+    _time_last_imu = ros::Time::now();
 
     //ROS_INFO_STREAM("Time_last_ok: " << _time_last_ok);
     //ROS_INFO_STREAM("Time_last_notOk: " << _time_last_notOk);
@@ -93,6 +126,13 @@ void OhmCat::start(const unsigned int rate)
     _loopRate = rate;
     _rate = new ros::Rate(_loopRate);
 
+    if(_imu_mode)
+    {//state machine runs in imu callback
+       ROS_INFO("ohm_cat -> imu mode... now rdy");
+       ros::spin();
+       return;
+    }
+
     //wait for first transform
     bool rdy = false;
     do{
@@ -141,116 +181,160 @@ void OhmCat::run()
           continue;
        }
 
-       Eigen::Quaternion<double> tmp_q(tf.getRotation().w(),
-                                       tf.getRotation().x(),
-                                       tf.getRotation().y(),
-                                       tf.getRotation().z() );
-
-       //get Pitch rot (rot y-asxis)
-       Eigen::Vector3d ez(0,0,1);
-       Eigen::Vector3d v = tmp_q * ez;
-       v.y() = 0;
-       double pitch = ::acos((v.dot(ez))/v.norm());
-       if(v.x() < 0)
-          pitch *= -1;
-
-       //get Roll rot (rot x-axis)
-       Eigen::Vector3d vr = tmp_q * ez;
-       vr.x() = 0;
-       double roll = ::acos((vr.dot(ez))/vr.norm());
-       if(vr.y() < 0)
-          roll *= -1;
+       double pitch;
+       double roll;
+       tiltOf(tf.getRotation().w(), tf.getRotation().x(), tf.getRotation().y(), tf.getRotation().z(), pitch, roll);
 
        //ROS_INFO("Pitch:  %f     ,   Roll:  %f", pitch / M_PI * 180, roll / M_PI * 180);
 
-       //todo prove if move mode check is needed
-       if(_state == ohm_cat::FIX_MOVE)
-       {
-          //prove of exit fix mode.. after time
-          if(ros::Time::now() - _time_last_notOk > _duration_move)
-          {
-             _time_last_move = ros::Time::now();
-             _state = ohm_cat::STOP;
-             //if(_state_old == ohm_cat::FIX_MOVE && _state == ohm_cat::STOP)
-                //this->setLaserinterupt(false);
-             _state_old = ohm_cat::STOP;
-             ROS_INFO("ohm_cat -> now Exit Fix Mode");
-          }
-       }
-       else
-       {
-
-          //detect flip
-          if( (std::abs(pitch) < _max_pitch && std::abs(roll) < _max_roll) &&
-              ((ros::Time::now() - _time_last_notOk) > _duration_ok)          )
-          {//okay
-             //ROS_INFO_STREAM("ohm_cat -> OK" << "time: " <<   (ros::Time::now() - _time_last_notOk));
-             _state = ohm_cat::OK;
-             //event
-             if(_state_old != ohm_cat::OK && _state == ohm_cat::OK)
-             {
-                this->event_OK();
-             }
-             _state_old = ohm_cat::OK;
-
-             _time_last_ok = ros::Time::now();
-          }
-          else if( (std::abs(pitch) >= _max_pitch || std::abs(roll) >= _max_roll) &&
-                   ((ros::Time::now() - _time_last_ok) > _duration_stop)           )
-          {//stop detected after time
-             _state = ohm_cat::STOP;
-             //event
-             if(_state_old != ohm_cat::STOP && _state == ohm_cat::STOP)
-             {
-                this->event_Stop();
-             }
-             _state_old = ohm_cat::STOP;
-
-             _time_last_notOk = ros::Time::now();
-             //ROS_INFO_STREAM("ohm_cat -> STOP" << "time: " <<  (ros::Time::now() - _time_last_ok));
-             //prove if a fix move is availible
-             if( (pitch < 0) && //&& std::abs(roll) < _max_roll) &&
-                 (ros::Time::now() - _time_last_ok > _duration_to_move) &&
-                 (ros::Time::now() - _time_last_move > _duration_next_move)   )
-             {
-                _direction = -1;
-                _state = ohm_cat::FIX_MOVE;
-
-                //event
-                if(_state_old != ohm_cat::FIX_MOVE && _state == ohm_cat::FIX_MOVE)
-                {
-                   this->event_Fix();
-                }
-                _state_old = ohm_cat::FIX_MOVE;
-
-                ROS_INFO("ohm_cat -> now Fix mode: move back");
-             }
-             else if( (pitch > 0 ) && //&& std::abs(roll) < _max_roll) &&
-                   (ros::Time::now() - _time_last_ok > _duration_to_move) &&
-                   (ros::Time::now() - _time_last_move > _duration_next_move)   )
-             {
-                _direction = 1;
-                _state = ohm_cat::FIX_MOVE;
-                //event
-                if(_state_old != ohm_cat::FIX_MOVE && _state == ohm_cat::FIX_MOVE)
-                {
-                   this->event_Fix();
-                }
-                _state_old = ohm_cat::FIX_MOVE;
-                ROS_INFO("ohm_cat -> now Fix mode: move forward");
-             }
-             else
-             {//stay STOP noting to do
-                _state = ohm_cat::STOP;
-             }
-          }
+       const bool tipping = this->predictTip(tf.stamp_, pitch, roll);
+       this->updateState(pitch, roll, tipping);
 
-       }
         ros::spinOnce();
         _rate->sleep();
     }
 }
 
+void OhmCat::updateState(const double pitch, const double roll, const bool tipping)
+{
+   //todo prove if move mode check is needed
+   if(_state == ohm_cat::FIX_MOVE)
+   {
+      //prove of exit fix mode.. after time
+      if(ros::Time::now() - _time_last_notOk > _duration_move)
+      {
+         _time_last_move = ros::Time::now();
+         _state = ohm_cat::STOP;
+         //if(_state_old == ohm_cat::FIX_MOVE && _state == ohm_cat::STOP)
+            //this->setLaserinterupt(false);
+         _state_old = ohm_cat::STOP;
+         ROS_INFO("ohm_cat -> now Exit Fix Mode");
+      }
+   }
+   else
+   {
+
+      //detect flip
+      if( (std::abs(pitch) < _max_pitch && std::abs(roll) < _max_roll) && !tipping &&
+          ((ros::Time::now() - _time_last_notOk) > _duration_ok)          )
+      {//okay
+         //ROS_INFO_STREAM("ohm_cat -> OK" << "time: " <<   (ros::Time::now() - _time_last_notOk));
+         _state = ohm_cat::OK;
+         //event
+         if(_state_old != ohm_cat::OK && _state == ohm_cat::OK)
+         {
+            this->event_OK();
+         }
+         _state_old = ohm_cat::OK;
+
+         _time_last_ok = ros::Time::now();
+      }
+      else if( (std::abs(pitch) >= _max_pitch || std::abs(roll) >= _max_roll) &&
+               ((ros::Time::now() - _time_last_ok) > _duration_stop)           )
+      {//stop detected after time
+         _state = ohm_cat::STOP;
+         //event
+         if(_state_old != ohm_cat::STOP && _state == ohm_cat::STOP)
+         {
+            this->event_Stop();
+         }
+         _state_old = ohm_cat::STOP;
+
+         _time_last_notOk = ros::Time::now();
+         //ROS_INFO_STREAM("ohm_cat -> STOP" << "time: " <<  (ros::Time::now() - _time_last_ok));
+         //prove if a fix move is availible
+         if( (pitch < 0) && //&& std::abs(roll) < _max_roll) &&
+             (ros::Time::now() - _time_last_ok > _duration_to_move) &&
+             (ros::Time::now() - _time_last_move > _duration_next_move)   )
+         {
+            _direction = -1;
+            _state = ohm_cat::FIX_MOVE;
+
+            //event
+            if(_state_old != ohm_cat::FIX_MOVE && _state == ohm_cat::FIX_MOVE)
+            {
+               this->event_Fix();
+            }
+            _state_old = ohm_cat::FIX_MOVE;
+
+            ROS_INFO("ohm_cat -> now Fix mode: move back");
+         }
+         else if( (pitch > 0 ) && //&& std::abs(roll) < _max_roll) &&
+               (ros::Time::now() - _time_last_ok > _duration_to_move) &&
+               (ros::Time::now() - _time_last_move > _duration_next_move)   )
+         {
+            _direction = 1;
+            _state = ohm_cat::FIX_MOVE;
+            //event
+            if(_state_old != ohm_cat::FIX_MOVE && _state == ohm_cat::FIX_MOVE)
+            {
+               this->event_Fix();
+            }
+            _state_old = ohm_cat::FIX_MOVE;
+            ROS_INFO("ohm_cat -> now Fix mode: move forward");
+         }
+         else
+         {//stay STOP noting to do
+            _state = ohm_cat::STOP;
+         }
+      }
+      else if(tipping)
+      {//limit predicted, stop before it is reached
+         _state = ohm_cat::STOP;
+         if(_state_old != ohm_cat::STOP)
+         {
+            _predict_triggers++;
+            _predict_triggers_total++;
+            ROS_INFO("ohm_cat -> tip over predicted");
+            this->event_Stop();
+         }
+         _state_old = ohm_cat::STOP;
+
+         _time_last_notOk = ros::Time::now();
+      }
+
+   }
+}
+
+bool OhmCat::predictTip(const ros::Time& stamp, const double pitch, const double roll)
+{
+   if(_predict_horizon <= 0)
+      return false;
+
+   const ros::WallTime start = ros::WallTime::now();
+   _predictor.add(stamp.toSec(), pitch, roll);
+   const double ttl = _predictor.timeToLimit(_max_pitch, _max_roll);
+   const double cost = (ros::WallTime::now() - start).toSec() * 1e6;
+
+   _predict_runs++;
+   _predict_cost_sum += cost;
+   _predict_cost_max = std::max(_predict_cost_max, cost);
+   _predict_ttl_min = std::min(_predict_ttl_min, ttl);
+   if(_predict_stats_period.toSec() > 0 && (start - _predict_stats_last).toSec() >= _predict_stats_period.toSec())
+   {
+      ROS_INFO("ohm_cat -> predictor: %u samples, %.2f us mean, %.2f us max, min time to limit %.3f s, %u early stops (%u total)",
+               _predict_runs, _predict_cost_sum / _predict_runs, _predict_cost_max, _predict_ttl_min,
+               _predict_triggers, _predict_triggers_total);
+      _predict_stats_last = start;
+      _predict_runs = 0;
+      _predict_cost_sum = 0;
+      _predict_cost_max = 0;
+      _predict_ttl_min = std::numeric_limits<double>::infinity();
+      _predict_triggers = 0;
+   }
+   return ttl < _predict_horizon;
+}
+
+void OhmCat::tiltOf(const double w, const double x, const double y, const double z, double& pitch, double& roll)
+{
+   //up axis of level frame seen from robot link: last row of rotation matrix
+   const double ux = 2.0 * (x * z - w * y);
+   const double uy = 2.0 * (y * z + w * x);
+   const double uz = 1.0 - 2.0 * (x * x + y * y);
+   pitch = ::atan2(-ux, uz);
+   roll  = ::atan2(-uy, uz);
+}
+
 bool OhmCat::setLaserinterupt(bool value)
 {
    ohm_apps_msgs::NodeControl srv;
@@ -276,6 +360,14 @@ void OhmCat::subVel_callback(const geometry_msgs::Twist& msg)
 {
    geometry_msgs::Twist vel = msg;
 
+   //silent imu is handled like a missing tf
+   if(_imu_mode && (ros::Time::now() - _time_last_imu > _imu_timeout))
+   {
+      ROS_ERROR_THROTTLE(1.0, "ohm_cat -> no imu data");
+      _state = ohm_cat::STOP;
+      _time_last_notOk = ros::Time::now();
+   }
+
    switch (_state) {
       case ohm_cat::OK:
          //nop
@@ -304,6 +396,38 @@ void OhmCat::subVel_callback(const geometry_msgs::Twist& msg)
    _pubVel.publish(vel);
 }
 
+void OhmCat::subImu_callback(const sensor_msgs::Imu& msg)
+{
+   const double dt = (msg.header.stamp - _stamp_last_imu).toSec();
+   _stamp_last_imu = msg.header.stamp;
+   _time_last_imu = ros::Time::now();
+
+   //covariance -1 marks imu without orientation (REP 145)
+   if(msg.orientation_covariance[0] >= 0)
+   {
+      tiltOf(msg.orientation.w, msg.orientation.x, msg.orientation.y, msg.orientation.z, _pitch, _roll);
+   }
+   else
+   {//complementary filter: gyro integrated, drift pulled towards tilt of gravity in accel
+      const double acc_pitch = ::atan2(-msg.linear_acceleration.x, msg.linear_acceleration.z);
+      const double acc_roll  = ::atan2(-msg.linear_acceleration.y, msg.linear_acceleration.z);
+      if(!_imu_init || dt <= 0 || dt > _imu_timeout.toSec())
+      {
+         _pitch = acc_pitch;
+         _roll  = acc_roll;
+      }
+      else
+      {
+         _pitch = _imu_filter_gain * (_pitch + msg.angular_velocity.y * dt) + (1.0 - _imu_filter_gain) * acc_pitch;
+         _roll  = _imu_filter_gain * (_roll  - msg.angular_velocity.x * dt) + (1.0 - _imu_filter_gain) * acc_roll;
+      }
+   }
+   _imu_init = true;
+
+   const bool tipping = this->predictTip(msg.header.stamp, _pitch, _roll);
+   this->updateState(_pitch, _roll, tipping);
+}
+
 void OhmCat::event_Stop()
 {
    ROS_INFO("ohm_cat -> event: Stop");
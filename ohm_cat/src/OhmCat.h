@@ -8,6 +8,7 @@
 #include <ros/ros.h>
 #include <tf/transform_listener.h>
 #include <geometry_msgs/Twist.h>
+#include <sensor_msgs/Imu.h>
 #include <ohm_apps_msgs/RobotEvent.h>
 #include <ohm_apps_msgs/Obstacle.h>
 
@@ -15,6 +16,8 @@
 
 #include <Eigen/Dense>
 
+#include "TipPredictor.h"
+
 
 using namespace Eigen;
 
@@ -41,6 +44,7 @@ private:    //dataelements
     ros::Publisher _pubEvent;
     ros::Publisher _pubHanky;
     ros::Subscriber _subVel;
+    ros::Subscriber _subImu;
 
     ros::ServiceClient _srv_slam;
 
@@ -68,6 +72,26 @@ private:    //dataelements
 
     int _direction;
 
+    bool _imu_mode;            ///tilt from imu samples instead of polling tf
+    bool _imu_init;            ///filter has a first sample
+    ros::Time _time_last_imu;   ///reception of last imu sample
+    ros::Time _stamp_last_imu;  ///stamp of last imu sample
+    ros::Duration _imu_timeout; ///stop if imu is silent for this time
+    double _imu_filter_gain;   ///weight of gyro integration against accel tilt, if imu has no orientation
+    double _pitch;
+    double _roll;
+
+    TipPredictor _predictor;
+    double _predict_horizon;      ///stop if limit is predicted within this time in [s], 0 disables prediction
+    ros::WallDuration _predict_stats_period;
+    ros::WallTime _predict_stats_last;
+    unsigned int _predict_runs;   ///predictions since last stats report
+    double _predict_cost_sum;     ///runtime of predictions since last stats report in [us]
+    double _predict_cost_max;
+    double _predict_ttl_min;      ///shortest predicted time to limit since last stats report
+    unsigned int _predict_triggers;       ///early stops since last stats report
+    unsigned int _predict_triggers_total;
+
     int _cnt;
 
 public:
@@ -101,11 +125,50 @@ private:    //functions
     void run();
 
 
+    /**
+     * @fn void updateState(const double pitch, const double roll, const bool tipping)
+     *
+     * @brief OK/STOP/FIX_MOVE state machine, called for every tilt sample
+     *
+     * @param[in] const double pitch  ->  pitch in [rad], positive if robot tips forward
+     * @param[in] const double roll   ->  roll in [rad]
+     * @param[in] const bool tipping  ->  limit predicted soon, stops without waiting for time_to_stop
+     *
+     * @return  void
+     */
+    void updateState(const double pitch, const double roll, const bool tipping = false);
+
+    /**
+     * @fn bool predictTip(const ros::Time& stamp, const double pitch, const double roll)
+     *
+     * @brief adds sample to predictor and reports its runtime cost and triggers every predict_stats_period
+     *
+     * @param[in] const ros::Time& stamp  ->  time of tilt sample
+     * @param[in] const double pitch      ->  in [rad]
+     * @param[in] const double roll       ->  in [rad]
+     *
+     * @return  true if a limit is predicted within the horizon
+     */
+    bool predictTip(const ros::Time& stamp, const double pitch, const double roll);
+
+    /**
+     * @fn static void tiltOf(const double w, const double x, const double y, const double z, double& pitch, double& roll)
+     *
+     * @brief pitch and roll of a rotation from level, independent of yaw
+     *
+     * @param[in] w, x, y, z  ->  rotation of robot link in a level frame
+     * @param[out] pitch, roll  ->  in [rad]
+     *
+     * @return  void
+     */
+    static void tiltOf(const double w, const double x, const double y, const double z, double& pitch, double& roll);
+
     bool setLaserinterupt(bool value);
 
 
     //void subCallback(const ROS_PACK::MESSAGE& msg);
     void subVel_callback(const geometry_msgs::Twist& msg);
+    void subImu_callback(const sensor_msgs::Imu& msg);
 
     void event_Stop();
     void event_Fix();
@@ -0,0 +1,129 @@
+#include "TipPredictor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+TipPredictor::TipPredictor(const unsigned int size)
+{
+   this->setSize(size);
+}
+
+TipPredictor::~TipPredictor()
+{
+}
+
+void TipPredictor::setSize(const unsigned int size)
+{
+   const unsigned int n = std::max(size, 3u);
+   _stamp.assign(n, 0.0);
+   _pitch.assign(n, 0.0);
+   _roll.assign(n, 0.0);
+   this->clear();
+}
+
+void TipPredictor::clear()
+{
+   _head = 0;
+   _count = 0;
+}
+
+void TipPredictor::add(const double stamp, const double pitch, const double roll)
+{
+   _stamp[_head] = stamp;
+   _pitch[_head] = pitch;
+   _roll[_head]  = roll;
+   _head = (_head + 1) % _stamp.size();
+   _count = std::min(_count + 1, (unsigned int)_stamp.size());
+}
+
+double TipPredictor::timeToLimit(const double max_pitch, const double max_roll) const
+{
+   double x, v, a;
+   double t = std::numeric_limits<double>::infinity();
+   if(this->fit(_pitch, x, v, a))
+      t = std::min(t, timeToLimit(x, v, a, max_pitch));
+   if(this->fit(_roll, x, v, a))
+      t = std::min(t, timeToLimit(x, v, a, max_roll));
+   return t;
+}
+
+bool TipPredictor::fit(const std::vector<double>& values, double& x, double& v, double& a) const
+{
+   if(_count < 3)
+      return false;
+
+   //time relative to newest sample, scaled by time span to keep the equations well conditioned
+   const unsigned int size   = _stamp.size();
+   const unsigned int newest = (_head + size - 1) % size;
+   const unsigned int oldest = (_head + size - _count) % size;
+   const double span = _stamp[newest] - _stamp[oldest];
+   if(!(span > 0))
+      return false;
+
+   double s0 = 0, s1 = 0, s2 = 0, s3 = 0, s4 = 0;
+   double y0 = 0, y1 = 0, y2 = 0;
+   for(unsigned int i = 0; i < _count; i++)
+   {
+      const unsigned int idx = (oldest + i) % size;
+      const double t  = (_stamp[idx] - _stamp[newest]) / span;
+      const double t2 = t * t;
+      const double y  = values[idx];
+      s0 += 1;
+      s1 += t;
+      s2 += t2;
+      s3 += t2 * t;
+      s4 += t2 * t2;
+      y0 += y;
+      y1 += y * t;
+      y2 += y * t2;
+   }
+
+   //normal equations of y = c0 + c1 * t + c2 * t^2, solved by cramer's rule
+   const double m0  = s2 * s4 - s3 * s3;
+   const double m1  = s1 * s4 - s2 * s3;
+   const double m2  = s1 * s3 - s2 * s2;
+   const double det = s0 * m0 - s1 * m1 + s2 * m2;
+   if(!(det > 1e-9 * s0 * s0 * s0))
+      return false;
+
+   const double c0 = (y0 * m0 - s1 * (y1 * s4 - s3 * y2) + s2 * (y1 * s3 - s2 * y2)) / det;
+   const double c1 = (s0 * (y1 * s4 - s3 * y2) - y0 * m1 + s2 * (s1 * y2 - y1 * s2)) / det;
+   const double c2 = (s0 * (s2 * y2 - s3 * y1) - s1 * (s1 * y2 - s2 * y1) + y0 * m2) / det;
+
+   x = c0;
+   v = c1 / span;
+   a = 2.0 * c2 / (span * span);
+   return true;
+}
+
+double TipPredictor::timeToLimit(const double x, const double v, const double a, const double limit)
+{
+   if(std::abs(x) >= limit)
+      return 0.0;
+
+   //first positive solution of x + v * t + a / 2 * t^2 = +-limit
+   double t = std::numeric_limits<double>::infinity();
+   const double targets[2] = {limit, -limit};
+   for(unsigned int i = 0; i < 2; i++)
+   {
+      const double d = x - targets[i];
+      if(std::abs(a) < 1e-9)
+      {
+         if(v != 0 && -d / v > 0)
+            t = std::min(t, -d / v);
+         continue;
+      }
+      const double disc = v * v - 2.0 * a * d;
+      if(disc < 0)
+         continue;
+      const double root = std::sqrt(disc);
+      const double t0 = (-v - root) / a;
+      const double t1 = (-v + root) / a;
+      if(t0 > 0)
+         t = std::min(t, t0);
+      if(t1 > 0)
+         t = std::min(t, t1);
+   }
+   return t;
+}
@@ -0,0 +1,67 @@
+#ifndef TIPPREDICTOR_H_
+#define TIPPREDICTOR_H_
+
+#include <vector>
+
+/**
+ * @class TipPredictor
+ *
+ * @brief estimates the time until pitch or roll reach their limits
+ *
+ * Keeps the last samples of pitch and roll in a ring buffer and fits a parabola over time to each of them by least
+ * squares. Angle, rate and acceleration of the fit at the newest sample are extrapolated to the limits.
+ */
+class TipPredictor
+{
+public:
+    TipPredictor(const unsigned int size = 16);
+    virtual ~TipPredictor();
+
+    /**
+     * @fn void setSize(const unsigned int size)
+     *
+     * @brief set number of samples in fit, at least 3, drops all samples
+     */
+    void setSize(const unsigned int size);
+
+    void clear();
+
+    /**
+     * @fn void add(const double stamp, const double pitch, const double roll)
+     *
+     * @param[in] const double stamp  ->  time of sample in [s], increasing
+     * @param[in] const double pitch  ->  in [rad]
+     * @param[in] const double roll   ->  in [rad]
+     */
+    void add(const double stamp, const double pitch, const double roll);
+
+    /**
+     * @fn double timeToLimit(const double max_pitch, const double max_roll) const
+     *
+     * @brief time from newest sample until |pitch| >= max_pitch or |roll| >= max_roll
+     *
+     * @return  time in [s], 0 if a limit is reached, infinity if not approached or too few samples
+     */
+    double timeToLimit(const double max_pitch, const double max_roll) const;
+
+private:    //functions
+    /**
+     * @fn bool fit(const std::vector<double>& values, double& x, double& v, double& a) const
+     *
+     * @brief parabola through samples, evaluated at newest sample
+     *
+     * @return  false if times of samples do not allow a fit
+     */
+    bool fit(const std::vector<double>& values, double& x, double& v, double& a) const;
+
+    static double timeToLimit(const double x, const double v, const double a, const double limit);
+
+private:    //dataelements
+    std::vector<double> _stamp;
+    std::vector<double> _pitch;
+    std::vector<double> _roll;
+    unsigned int _head;    ///next sample is written here
+    unsigned int _count;
+};
+
+#endif /* TIPPREDICTOR_H_ */
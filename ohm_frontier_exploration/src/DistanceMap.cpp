@@ -0,0 +1,191 @@
+/*
+ * DistanceMap.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "DistanceMap.h"
+
+#include "FrontierFinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+const unsigned int NOT_REACHED   = std::numeric_limits<unsigned int>::max();
+const unsigned int COST_STRAIGHT = 2;
+const unsigned int COST_DIAGONAL = 3;
+
+/**
+ * Function to check if a cell is free and not blocked
+ */
+inline bool isPassable(const signed char* data, const unsigned char* mask, int idx)
+{
+   return (data[idx] == autonohm::frontier::FREE) && !(mask && mask[idx]);
+}
+}
+
+namespace autonohm {
+namespace frontier {
+
+DistanceMap::DistanceMap(void) :
+      _starts(0)
+    , _width(0)
+    , _height(0)
+    , _resolution(0.0f)
+    , _origin_x(0.0)
+    , _origin_y(0.0)
+{
+
+}
+
+DistanceMap::~DistanceMap(void)
+{
+   // nothing to do
+}
+
+bool DistanceMap::compute(const nav_msgs::OccupancyGrid& map, const geometry_msgs::Point& start,
+                          const std::vector<unsigned char>* blocked)
+{
+   return this->compute(map, std::vector<geometry_msgs::Point>(1, start), blocked);
+}
+
+
+bool DistanceMap::compute(const nav_msgs::OccupancyGrid& map, const std::vector<geometry_msgs::Point>& starts,
+                          const std::vector<unsigned char>* blocked)
+{
+   _width      = map.info.width;
+   _height     = map.info.height;
+   _resolution = map.info.resolution;
+   _origin_x   = map.info.origin.position.x;
+   _origin_y   = map.info.origin.position.y;
+   _starts     = starts.size();
+
+   _cost.assign(map.data.size() * _starts, NOT_REACHED);
+
+   if(!_starts || map.data.size() != _width * _height)
+      return false;
+
+   if(blocked && blocked->size() != map.data.size())
+      blocked = NULL;
+
+   const int w = _width;
+   const int h = _height;
+   const int k = _starts;
+   const signed char*   data = &map.data[0];
+   const unsigned char* mask = blocked ? &(*blocked)[0] : NULL;
+
+   for(unsigned int i=0 ; i<4 ; i++) _buckets[i].clear();
+
+   // entries of queue are indices in cost vector, so each start keeps its own wavefront
+   bool inside = true;
+   unsigned int pending = 0;
+   for(int s=0 ; s<k ; s++)
+   {
+      const int sx = std::floor((starts[s].x - _origin_x) / _resolution);
+      const int sy = std::floor((starts[s].y - _origin_y) / _resolution);
+      if(sx < 0 || sy < 0 || sx >= w || sy >= h)
+      {
+         inside = false;
+         continue;
+      }
+
+      // start cell is taken even if it is not free, robot may stand in unknown space
+      _cost[(sy * w + sx) * k + s] = 0;
+      _buckets[0].push_back((sy * w + sx) * k + s);
+      pending++;
+   }
+
+   for(unsigned int d=0 ; pending ; d++)
+   {
+      // steps cost at least 2, so no cell is added to the bucket being processed
+      std::vector<unsigned int>& bucket = _buckets[d & 3];
+
+      for(unsigned int i=0 ; i<bucket.size() ; i++)
+      {
+         const unsigned int entry = bucket[i];
+         if(_cost[entry] != d)
+            continue;                           // cell was reached cheaper before
+
+         const int idx = entry / k;
+         const int s   = entry % k;
+         const int x   = idx % w;
+         const int y   = idx / w;
+
+         const bool left  = (x > 0)     && isPassable(data, mask, idx - 1);
+         const bool right = (x + 1 < w) && isPassable(data, mask, idx + 1);
+         const bool down  = (y > 0)     && isPassable(data, mask, idx - w);
+         const bool up    = (y + 1 < h) && isPassable(data, mask, idx + w);
+
+         int          n[8];
+         unsigned int c[8];
+         unsigned int num = 0;
+         if(left)  { n[num] = idx - 1; c[num++] = COST_STRAIGHT; }
+         if(right) { n[num] = idx + 1; c[num++] = COST_STRAIGHT; }
+         if(down)  { n[num] = idx - w; c[num++] = COST_STRAIGHT; }
+         if(up)    { n[num] = idx + w; c[num++] = COST_STRAIGHT; }
+
+         // diagonal steps must not cut corners of obstacles
+         if(left  && down && isPassable(data, mask, idx - w - 1)) { n[num] = idx - w - 1; c[num++] = COST_DIAGONAL; }
+         if(right && down && isPassable(data, mask, idx - w + 1)) { n[num] = idx - w + 1; c[num++] = COST_DIAGONAL; }
+         if(left  && up   && isPassable(data, mask, idx + w - 1)) { n[num] = idx + w - 1; c[num++] = COST_DIAGONAL; }
+         if(right && up   && isPassable(data, mask, idx + w + 1)) { n[num] = idx + w + 1; c[num++] = COST_DIAGONAL; }
+
+         for(unsigned int j=0 ; j<num ; j++)
+         {
+            const unsigned int next = n[j] * k + s;
+            const unsigned int cost = d + c[j];
+            if(cost < _cost[next])
+            {
+               _cost[next] = cost;
+               _buckets[cost & 3].push_back(next);
+               pending++;
+            }
+         }
+      }
+
+      pending -= bucket.size();
+      bucket.clear();
+   }
+
+   return inside;
+}
+
+
+float DistanceMap::getDistance(const geometry_msgs::Point& p, int radius, unsigned int start) const
+{
+   if(_cost.empty() || start >= _starts)
+      return -1.0f;
+
+   const int px = std::floor((p.x - _origin_x) / _resolution);
+   const int py = std::floor((p.y - _origin_y) / _resolution);
+
+   unsigned int best = NOT_REACHED;
+   for(int y=py-radius ; y<=py+radius ; y++)
+   {
+      if(y < 0 || y >= static_cast<int>(_height)) continue;
+      for(int x=px-radius ; x<=px+radius ; x++)
+      {
+         if(x < 0 || x >= static_cast<int>(_width)) continue;
+         best = std::min(best, _cost[(y * _width + x) * _starts + start]);
+      }
+   }
+
+   if(best == NOT_REACHED)
+      return -1.0f;
+
+   return best * _resolution / COST_STRAIGHT;
+}
+
+
+bool DistanceMap::isReached(unsigned int idx, unsigned int start) const
+{
+   if(idx >= _width * _height || start >= _starts)
+      return false;
+
+   return _cost[idx * _starts + start] != NOT_REACHED;
+}
+
+} /* namespace frontier */
+} /* namespace autonohm */
@@ -0,0 +1,103 @@
+/*
+ * DistanceMap.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef OHM_FRONTIER_EXPLORATION_SRC_DISTANCEMAP_H_
+#define OHM_FRONTIER_EXPLORATION_SRC_DISTANCEMAP_H_
+
+#include <nav_msgs/OccupancyGrid.h>
+#include <geometry_msgs/Point.h>
+
+#include <vector>
+
+/**
+ * @namespace autonohm
+ */
+namespace autonohm {
+
+namespace frontier {
+
+/**
+ * @class   DistanceMap
+ * @date    2026-10-19
+ *
+ * @brief   Path length from one or more start cells to every free cell of a map.
+ *
+ * Wavefront over free cells with 8-neighbourhood. Straight steps cost 2,
+ * diagonal steps 3, so a bucket queue with four buckets gives the result in
+ * linear time. Several start cells share one queue, every cell keeps a path
+ * length per start cell.
+ */
+class DistanceMap
+{
+public:
+   /**
+    * Default constructor
+    */
+   DistanceMap(void);
+   /**
+    * Default destructor
+    */
+   virtual ~DistanceMap(void);
+
+   // PROCESSING
+   /**
+    * Function to calculate path lengths from start to all free cells
+    * @param map           occupancy grid, only FREE cells can be passed
+    * @param start         start point in map frame
+    * @param blocked       optional mask of cells which can not be passed, e.g. inflated obstacles
+    * @return              false if start is not in map
+    */
+   bool compute(const nav_msgs::OccupancyGrid& map, const geometry_msgs::Point& start,
+                const std::vector<unsigned char>* blocked = NULL);
+   /**
+    * Function to calculate path lengths from several starts to all free cells in one wavefront
+    * @param map           occupancy grid, only FREE cells can be passed
+    * @param starts        start points in map frame, e.g. poses of several robots
+    * @param blocked       optional mask of cells which can not be passed, e.g. inflated obstacles
+    * @return              false if a start is not in map
+    */
+   bool compute(const nav_msgs::OccupancyGrid& map, const std::vector<geometry_msgs::Point>& starts,
+                const std::vector<unsigned char>* blocked = NULL);
+
+   // GETTERS
+   /**
+    * Function to get path length to a point.
+    * Takes closest reached cell around point, because frontiers may lie in unknown space.
+    * @param p             point in map frame
+    * @param radius        search radius around point in cells
+    * @param start         index of start point
+    * @return              path length in meters, negative if not reachable
+    */
+   float getDistance(const geometry_msgs::Point& p, int radius = 3, unsigned int start = 0) const;
+   /**
+    * Function to check if a cell was reached from a start
+    * @param idx           index of cell
+    * @param start         index of start point
+    * @return
+    */
+   bool isReached(unsigned int idx, unsigned int start = 0) const;
+   /**
+    * Function to get number of start points of last calculation
+    * @return
+    */
+   unsigned int getNumStarts(void) const                          { return _starts; }
+
+private:
+   std::vector<unsigned int>  _cost;               //!< path length in half cells for every cell and start
+   unsigned int               _starts;             //!< number of start points
+   std::vector<unsigned int>  _buckets[4];         //!< queue of cells by cost
+   unsigned int               _width;
+   unsigned int               _height;
+   float                      _resolution;
+   double                     _origin_x;
+   double                     _origin_y;
+};
+
+} /* namespace frontier */
+
+} /* namespace autonohm */
+
+#endif /* OHM_FRONTIER_EXPLORATION_SRC_DISTANCEMAP_H_ */
@@ -12,8 +12,6 @@
 #include <geometry_msgs/Pose.h>
 #include <geometry_msgs/Quaternion.h>
 
-#include <tf/LinearMath/Vector3.h>
-
 /**
  * @namespace autonohm
  */
@@ -40,22 +38,23 @@ public:
 struct WeightedFrontier
 {
    Frontier       frontier;
-   float          size;
+   unsigned int   id;                   //!< id which stays the same over map updates
+   float          size;                 //!< extent along principal axis in cells
+   float          gain;                 //!< number of unknown cells visible from frontier
+   float          path_cost;            //!< path length from robot in meters, negative if not reachable
    float          weight;
+   bool           cached;               //!< gain was taken over from last update
 
+   /*
+    * frontiers with equal weight are ordered by id, so the best frontier
+    * does not change between equally weighted candidates
+    */
    bool operator<(const WeightedFrontier& f) const {
-      return weight > f.weight;
+      if(weight != f.weight) return weight > f.weight;
+      return id > f.id;
    }
 };
 
-/**
- * @struct  FrontierPoint
- */
-struct FrontierPoint {
-   int idx;
-   tf::Vector3 orientation;
-};
-
 } /* namespace autonohm */
 
 #endif /* OHM_FRONTIER_EXPLORATION_SRC_FRONTIER_H_ */
@@ -0,0 +1,187 @@
+/*
+ * FrontierAllocator.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "FrontierAllocator.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+const double FORBIDDEN = 1e9;          //!< cost of pairs which must not be assigned
+
+/**
+ * @struct Pair
+ */
+struct Pair
+{
+   float        cost;
+   unsigned int robot;
+   unsigned int frontier;
+
+   bool operator<(const Pair& p) const { return cost < p.cost; }
+};
+}
+
+namespace autonohm {
+namespace frontier {
+
+FrontierAllocator::FrontierAllocator(unsigned int max_hungarian) :
+      _max_hungarian(max_hungarian)
+{
+
+}
+
+FrontierAllocator::~FrontierAllocator(void)
+{
+   // nothing to do
+}
+
+double FrontierAllocator::allocate(const std::vector<std::vector<float> >& cost, std::vector<int>& assignment) const
+{
+   if(cost.size() <= _max_hungarian)
+      return hungarian(cost, assignment);
+   return greedy(cost, assignment);
+}
+
+
+double FrontierAllocator::greedy(const std::vector<std::vector<float> >& cost, std::vector<int>& assignment)
+{
+   assignment.assign(cost.size(), -1);
+
+   std::vector<Pair> pairs;
+   for(unsigned int r=0 ; r<cost.size() ; r++)
+   {
+      for(unsigned int f=0 ; f<cost[r].size() ; f++)
+      {
+         if(cost[r][f] < 0.0f) continue;
+
+         Pair p;
+         p.cost     = cost[r][f];
+         p.robot    = r;
+         p.frontier = f;
+         pairs.push_back(p);
+      }
+   }
+   std::sort(pairs.begin(), pairs.end());
+
+   const unsigned int frontiers = cost.empty() ? 0 : cost[0].size();
+   std::vector<bool> taken(frontiers, false);
+   double sum = 0.0;
+
+   for(unsigned int i=0 ; i<pairs.size() ; i++)
+   {
+      if(assignment[pairs[i].robot] >= 0 || taken[pairs[i].frontier])
+         continue;
+
+      assignment[pairs[i].robot] = pairs[i].frontier;
+      taken[pairs[i].frontier]   = true;
+      sum += pairs[i].cost;
+   }
+   return sum;
+}
+
+
+double FrontierAllocator::hungarian(const std::vector<std::vector<float> >& cost, std::vector<int>& assignment)
+{
+   const unsigned int robots    = cost.size();
+   const unsigned int frontiers = robots ? cost[0].size() : 0;
+
+   assignment.assign(robots, -1);
+   if(!robots || !frontiers)
+      return 0.0;
+
+   // method needs at most as many rows as columns, rows are frontiers if there are more robots
+   const bool         transposed = robots > frontiers;
+   const unsigned int n          = transposed ? frontiers : robots;
+   const unsigned int m          = transposed ? robots    : frontiers;
+
+   std::vector<std::vector<double> > a(n + 1, std::vector<double>(m + 1, 0.0));
+   for(unsigned int r=0 ; r<robots ; r++)
+   {
+      for(unsigned int f=0 ; f<frontiers ; f++)
+      {
+         const double c = (cost[r][f] < 0.0f) ? FORBIDDEN : cost[r][f];
+         if(transposed) a[f + 1][r + 1] = c;
+         else           a[r + 1][f + 1] = c;
+      }
+   }
+
+   // potentials u, v and matching p of columns to rows, all 1-based
+   const double inf = std::numeric_limits<double>::max();
+   std::vector<double>       u(n + 1, 0.0), v(m + 1, 0.0);
+   std::vector<unsigned int> p(m + 1, 0), way(m + 1, 0);
+
+   for(unsigned int i=1 ; i<=n ; i++)
+   {
+      p[0] = i;
+      unsigned int j0 = 0;
+      std::vector<double> minv(m + 1, inf);
+      std::vector<bool>   used(m + 1, false);
+
+      do
+      {
+         used[j0] = true;
+         const unsigned int i0 = p[j0];
+         double       delta = inf;
+         unsigned int j1    = 0;
+
+         for(unsigned int j=1 ; j<=m ; j++)
+         {
+            if(used[j]) continue;
+
+            const double cur = a[i0][j] - u[i0] - v[j];
+            if(cur < minv[j])
+            {
+               minv[j] = cur;
+               way[j]  = j0;
+            }
+            if(minv[j] < delta)
+            {
+               delta = minv[j];
+               j1    = j;
+            }
+         }
+
+         for(unsigned int j=0 ; j<=m ; j++)
+         {
+            if(used[j])
+            {
+               u[p[j]] += delta;
+               v[j]    -= delta;
+            }
+            else
+            {
+               minv[j] -= delta;
+            }
+         }
+         j0 = j1;
+      } while(p[j0] != 0);
+
+      // augment along alternating path
+      do
+      {
+         const unsigned int j1 = way[j0];
+         p[j0] = p[j1];
+         j0    = j1;
+      } while(j0);
+   }
+
+   double sum = 0.0;
+   for(unsigned int j=1 ; j<=m ; j++)
+   {
+      if(!p[j] || a[p[j]][j] >= FORBIDDEN)
+         continue;
+
+      const unsigned int r = transposed ? j - 1    : p[j] - 1;
+      const unsigned int f = transposed ? p[j] - 1 : j - 1;
+      assignment[r] = f;
+      sum += a[p[j]][j];
+   }
+   return sum;
+}
+
+} /* namespace frontier */
+} /* namespace autonohm */
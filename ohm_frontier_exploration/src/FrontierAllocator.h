@@ -0,0 +1,79 @@
+/*
+ * FrontierAllocator.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef OHM_FRONTIER_EXPLORATION_SRC_FRONTIERALLOCATOR_H_
+#define OHM_FRONTIER_EXPLORATION_SRC_FRONTIERALLOCATOR_H_
+
+#include <vector>
+
+/**
+ * @namespace autonohm
+ */
+namespace autonohm {
+
+namespace frontier {
+
+/**
+ * @class   FrontierAllocator
+ * @date    2026-10-19
+ *
+ * @brief   Assigns a distinct frontier to every robot.
+ *
+ * Minimizes the sum of costs with the hungarian method for small teams,
+ * larger teams take the cheapest remaining pair of robot and frontier.
+ */
+class FrontierAllocator
+{
+public:
+   /**
+    * Constructor
+    * @param max_hungarian       maximum number of robots solved with the hungarian method
+    */
+   FrontierAllocator(unsigned int max_hungarian = 8);
+   /**
+    * Default destructor
+    */
+   virtual ~FrontierAllocator(void);
+
+   // SETTERS
+   /**
+    * Function to set maximum number of robots solved with the hungarian method
+    * @param n
+    */
+   void setMaxHungarian(unsigned int n)                           { _max_hungarian = n; }
+
+   // PROCESSING
+   /**
+    * Function to assign frontiers to robots
+    * @param cost          cost[r][f] of robot r for frontier f, negative if robot can not reach frontier
+    * @param assignment    index of frontier for every robot, -1 if none is left
+    * @return              sum of costs of assigned pairs
+    */
+   double allocate(const std::vector<std::vector<float> >& cost, std::vector<int>& assignment) const;
+   /**
+    * Function to assign cheapest remaining pair of robot and frontier until none is left
+    * @param cost          cost[r][f] of robot r for frontier f, negative if robot can not reach frontier
+    * @param assignment    index of frontier for every robot, -1 if none is left
+    * @return              sum of costs of assigned pairs
+    */
+   static double greedy(const std::vector<std::vector<float> >& cost, std::vector<int>& assignment);
+   /**
+    * Function to assign frontiers with minimum sum of costs, O(n^2 m) for n robots and m frontiers
+    * @param cost          cost[r][f] of robot r for frontier f, negative if robot can not reach frontier
+    * @param assignment    index of frontier for every robot, -1 if none is left
+    * @return              sum of costs of assigned pairs
+    */
+   static double hungarian(const std::vector<std::vector<float> >& cost, std::vector<int>& assignment);
+
+private:
+   unsigned int                  _max_hungarian;
+};
+
+} /* namespace frontier */
+
+} /* namespace autonohm */
+
+#endif /* OHM_FRONTIER_EXPLORATION_SRC_FRONTIERALLOCATOR_H_ */
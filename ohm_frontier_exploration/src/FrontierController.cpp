@@ -7,8 +7,8 @@
 
 #include "FrontierController.h"
 
-#include <tf/tf.h>
-#include <tf/transform_listener.h>
+#include <algorithm>
+#include <cmath>
 
 namespace autonohm {
 
@@ -18,6 +18,7 @@ FrontierController::FrontierController(void)
    _config.euclideanDistanceFactor = 2;
    _config.orientationFactor       = 0;
    _config.sizeFactor              = 0.1;
+   _config.gainFactor              = 0;
 
    _config.maxEuclideanDistance    = 12.0;
 }
@@ -33,28 +34,28 @@ void FrontierController::setWeightedFrontiers(const std::vector<WeightedFrontier
    _wf = wf;
 }
 
-void FrontierController::findBestFrontier(void)
+void FrontierController::findBestFrontier(const geometry_msgs::Pose& robot)
 {
-   /*
-    * get position of robot to map coordinate system
-    */
-   tf::TransformListener listener;
-   tf::StampedTransform transform;
-
-   try {
-      listener.waitForTransform(_map_topic,            _base_footprint_topic, ros::Time(0), ros::Duration(1.0) );
-      listener.lookupTransform( _base_footprint_topic, _base_footprint_topic, ros::Time(0), transform);
+   if(rankFrontiers(_wf, robot, _config))
+   {
+      // set best frontier with lowest weight
+      _bestFrontier = _wf.back().frontier;
    }
-   catch (tf::TransformException ex) {
-      ROS_ERROR("%s",ex.what());
+}
 
-   }
 
-   const double x = transform.getOrigin().x();
-   const double y = transform.getOrigin().y();
+bool FrontierController::rankFrontiers(std::vector<WeightedFrontier>& wf,
+                                       const geometry_msgs::Pose& robot,
+                                       const FrontierControllerConfig& config)
+{
+   if(wf.empty())
+      return false;
+
+   const double x = robot.position.x;
+   const double y = robot.position.y;
 
    // calculate weight for all frontiers
-   for(std::vector<WeightedFrontier>::iterator it=_wf.begin() ; it!=_wf.end() ; ++it)
+   for(std::vector<WeightedFrontier>::iterator it=wf.begin() ; it!=wf.end() ; ++it)
    {
       const float diffX          = it->frontier.position.x - x;
       const float diffY          = it->frontier.position.y - y;
@@ -63,13 +64,15 @@ void FrontierController::findBestFrontier(void)
 
       const float ori            = 0;
 
-      const float sizeWeight     = it->size   * _config.sizeFactor;
-      const float euclDistWeight = (1.0/dist) * _config.euclideanDistanceFactor;
-      const float oriWeight      = ori        * _config.orientationFactor;
+      const float sizeWeight     = it->size   * config.sizeFactor;
+      const float euclDistWeight = (1.0/dist) * config.euclideanDistanceFactor;
+      const float oriWeight      = ori        * config.orientationFactor;
+      const float gainWeight     = it->gain   * config.gainFactor;
 
-      // sum up all weights
-      float weight         = sizeWeight + euclDistWeight + oriWeight;
-      if(dist > _config.maxEuclideanDistance) weight = 1000;
+      // sum up all weights, weight is a cost: the frontier with the lowest weight is chosen,
+      // so unknown cells seen from a frontier lower its weight
+      float weight         = sizeWeight + euclDistWeight + oriWeight - gainWeight;
+      if(dist > config.maxEuclideanDistance) weight = 1000;
 
       // set weight to object
       it->weight = weight;
@@ -77,11 +80,9 @@ void FrontierController::findBestFrontier(void)
 
 
    // sort frontiers for their weight
-   std::sort(_wf.begin(), _wf.end());
+   std::sort(wf.begin(), wf.end());
 
-   // set best frontier with lowest weight
-   _bestFrontier = _wf.back().frontier;
+   return true;
 }
 
-
 };
@@ -10,6 +10,7 @@
 
 // ros includes
 #include <ros/ros.h>
+#include <geometry_msgs/Pose.h>
 
 //
 #include "Frontier.h"
@@ -29,6 +30,7 @@ struct FrontierControllerConfig
    float sizeFactor;                   //!< factor to be multiplied with frontier size
    float euclideanDistanceFactor;      //!< factor to be multiplied with euclidean distance to robot's pose
    float orientationFactor;            //!< factor to be multiplied with orientation to robot's pose
+   float gainFactor;                   //!< factor to be multiplied with information gain, lowers the weight
 
    float maxEuclideanDistance;         //!< maximum value for distance to travel to next
 };
@@ -69,11 +71,6 @@ public:
     */
    void setConfig(FrontierControllerConfig config) { _config = config; }
 
-   void setTFFrameIds(std::string map_frame_id, std::string base_footprint_frame_id) {
-      _map_topic            = map_frame_id;
-      _base_footprint_topic = base_footprint_frame_id;
-   }
-
 
    // GETTERS
    /**
@@ -87,8 +84,21 @@ public:
    // PROCESSING
    /**
     * Function to start processing
+    * @param robot         pose of the robot in map frame at the time of the map
+    */
+   void findBestFrontier(const geometry_msgs::Pose& robot);
+
+   /**
+    * Function to weight and sort frontiers relative to the robot's pose.
+    * Does not touch ros or tf, so it never blocks and can be benchmarked offline.
+    * @param wf            frontiers to weight, sorted in place
+    * @param robot         pose of the robot in map frame
+    * @param config        weighting factors
+    * @return              false if there is no frontier to choose from
     */
-   void findBestFrontier(void);
+   static bool rankFrontiers(std::vector<WeightedFrontier>& wf,
+                             const geometry_msgs::Pose& robot,
+                             const FrontierControllerConfig& config);
 
 
 private:
@@ -96,10 +106,6 @@ private:
    std::vector<WeightedFrontier> _wf;                 //!< all weighted frontiers
 
    FrontierControllerConfig      _config;
-
-   std::string                   _map_topic;
-   std::string                   _base_footprint_topic;
-
 };
 
 };
@@ -9,6 +9,9 @@
 
 #include <visualization_msgs/Marker.h>
 #include "geometry_msgs/PoseArray.h"
+#include "ohm_autonomy_msgs/FrontierUpdate.h"
+
+#include <sstream>
 
 // dynamic reconfigure
 #include <dynamic_reconfigure/server.h>
@@ -16,6 +19,20 @@
 
 
 
+namespace {
+ohm_autonomy_msgs::Frontier toMsg(const autonohm::WeightedFrontier& wf)
+{
+   ohm_autonomy_msgs::Frontier f;
+   f.id        = wf.id;
+   f.pose      = wf.frontier;
+   f.size      = wf.size;
+   f.gain      = wf.gain;
+   f.score     = wf.weight;
+   f.path_cost = wf.path_cost;
+   return f;
+}
+}
+
 namespace autonohm {
 
 // initialization of singleton pattern
@@ -30,11 +47,10 @@ FrontierExplorationNode* FrontierExplorationNode::getInstance(void)
 
 void FrontierExplorationNode::run(void)
 {
-   ros::Rate looprate(_rate);
-   while(ros::ok()) {
-      ros::spinOnce();
-      looprate.sleep();
-   }
+   // map callback only hands over the map, so service calls are answered while a map is processed
+   ros::AsyncSpinner spinner(_spinner_threads);
+   spinner.start();
+   ros::waitForShutdown();
 }
 
 bool FrontierExplorationNode::isInitialized(void)
@@ -45,14 +61,21 @@ bool FrontierExplorationNode::isInitialized(void)
 
 void FrontierExplorationNode::setDynamicConfig(FrontierControllerConfig c)
 {
-   _frontierController->setConfig(c);
+   boost::mutex::scoped_lock lock(_config_mutex);
+   _controller_config = c;
+   _config_changed    = true;
 }
 
 
 FrontierExplorationNode::FrontierExplorationNode(void) :
-      _frontierFinder(NULL)
+      _dropped_maps(0)
+,     _shutdown(false)
+,     _config_changed(false)
+,     _frontierFinder(NULL)
 ,     _is_initialized(false)
-,     _rate(5.0)
+,     _spinner_threads(2)
+,     _robot_radius(0.6)
+,     _use_reachability(true)
 {
    ros::NodeHandle private_nh("~");
 
@@ -60,56 +83,115 @@ FrontierExplorationNode::FrontierExplorationNode(void) :
    private_nh.param<double>("robot_radius",               config.robot_radius,               0.6);
    private_nh.param<double>("min_dist_between_frontiers", config.min_dist_between_frontiers, 1.0);
    private_nh.param<double>("max_search_radius",          config.max_search_radius,          10.0);
+   private_nh.param<int>(   "pyramid_levels",             config.pyramid_levels,             3);
+   private_nh.param<double>("standoff_distance",          config.standoff_distance,          0.2);
+
+   frontier::InformationGainConfig gainConfig;
+   double sensor_resolution;
+   private_nh.param<double>("sensor_range",               gainConfig.sensor_range,           5.0);
+   private_nh.param<double>("sensor_resolution",          sensor_resolution,                 1.0);
+   gainConfig.angular_resolution = sensor_resolution * M_PI / 180.0;
 
    _frontierFinder     = new frontier::Finder(config);
    _frontierController = new FrontierController;
+   _informationGain    = new frontier::InformationGain(gainConfig);
+   _tracker            = new frontier::FrontierTracker(config.min_dist_between_frontiers, gainConfig.sensor_range);
 
    std::string map_topic;
    std::string frontier_topic;
-   std::string base_topic;
    private_nh.param("map_topic",             map_topic,      std::string("/map"));
-   private_nh.param("base_footprint_topic",  base_topic,     std::string("laser"));
+   private_nh.param("base_footprint_topic",  _base_frame,    std::string("laser"));
    private_nh.param("frontier_topic",        frontier_topic, std::string("frontiers"));
+   private_nh.param<int>("spinner_threads",  _spinner_threads, 2);
+   private_nh.param<bool>("use_reachability", _use_reachability, true);
+   _robot_radius = config.robot_radius;
+
+   // further robots from tf frames or as fixed poses (x, y, yaw) in map frame for tests
+   std::vector<std::string> robot_frames;
+   std::vector<double>      simulated_robots;
+   int                      max_hungarian;
+   private_nh.getParam("robot_frames",     robot_frames);
+   private_nh.getParam("simulated_robots", simulated_robots);
+   private_nh.param<int>("max_hungarian",  max_hungarian, 8);
+   _allocator.setMaxHungarian(max_hungarian);
+
+   for(unsigned int i=0 ; i<robot_frames.size() ; i++)
+   {
+      frontier::Robot robot;
+      robot.name                  = robot_frames[i];
+      robot.simulated             = false;
+      robot.pose.orientation.w    = 1.0;
+      _team.push_back(robot);
+   }
+   for(unsigned int i=0 ; i+2<simulated_robots.size() ; i+=3)
+   {
+      std::stringstream name;
+      name << "simulated_" << i / 3;
+
+      frontier::Robot robot;
+      robot.name                  = name.str();
+      robot.simulated             = true;
+      robot.pose.position.x       = simulated_robots[i];
+      robot.pose.position.y       = simulated_robots[i + 1];
+      robot.pose.orientation      = tf::createQuaternionMsgFromYaw(simulated_robots[i + 2]);
+      _team.push_back(robot);
+   }
+   if(_team.size())
+      ROS_INFO("ohm_frontier_exploration -> sharing frontiers with %u further robots", (unsigned int)_team.size());
 
-   _frontierController->setTFFrameIds(map_topic, base_topic);
+   _robot_pose.orientation.w = 1.0;
 
    // Publishers
    _frontier_pub      = _nh.advertise<geometry_msgs::PoseArray>(frontier_topic,  1);
+   _frontier_update_pub = _nh.advertise<ohm_autonomy_msgs::FrontierUpdate>(frontier_topic + "/updates", 10);
 
    // Subscriber
    _map_sub           = _nh.subscribe(map_topic, 1, &FrontierExplorationNode::mapCallback, this);
    _sub_map_pub       = _nh.advertise<nav_msgs::OccupancyGrid>("sub_map",  1);
-   _frontier_grid_pub = _nh.advertise<nav_msgs::GridCells>("frontier_grid", 1);
 
    // Service Server
    _best_target_service = private_nh.advertiseService("get_target", &FrontierExplorationNode::getFrontierServiceCB, this);
+   _all_targets_service = private_nh.advertiseService("get_frontiers", &FrontierExplorationNode::getAllFrontierServiceCB, this);
+   _assignment_service  = private_nh.advertiseService("get_assignment", &FrontierExplorationNode::getAssignmentServiceCB, this);
    _transmitt_targets_service = _nh.advertiseService("frontier/node_control", &FrontierExplorationNode::callback_srv_transmittTargets, this);
 
+   double viz_rate;
+   private_nh.param<double>("viz_rate",      viz_rate,       2.0);
    _viz.setNodeHandle(_nh);
+   _viz.setRate(viz_rate);
 
    _is_initialized = true;
 
-   //set runMode
-   _mode = frontier::STOP;
+   // without autostart the node waits for START or SINGLESHOT
+   bool autostart;
+   private_nh.param<bool>("autostart", autostart, true);
+   _mode = autostart ? frontier::RUN : frontier::STOP;
 
-   // start node
-   this->run();
+   // start processing of maps, callbacks are served by run()
+   _worker = boost::thread(&FrontierExplorationNode::processMaps, this);
 }
 
 
 FrontierExplorationNode::~FrontierExplorationNode(void)
 {
-   if(_instance) {
-      delete _instance;
-      _instance = 0;
+   {
+      boost::mutex::scoped_lock lock(_map_mutex);
+      _shutdown = true;
    }
+   _map_condition.notify_all();
+   _worker.join();
+
+   if(_instance == this)
+      _instance = 0;
 
    delete _frontierFinder;
    delete _frontierController;
+   delete _informationGain;
+   delete _tracker;
 }
 
 
-void FrontierExplorationNode::findFrontiers(void)
+void FrontierExplorationNode::findFrontiers(const nav_msgs::OccupancyGrid::ConstPtr& map)
 {
    if(_frontierFinder->isInitialized())
    {
@@ -117,16 +199,94 @@ void FrontierExplorationNode::findFrontiers(void)
 
       ROS_INFO("----------- Frontier Finder --------------- NUM_FRONTIER: %d", _frontierFinder->getFrontiers().size());
 
-      //_frontiers = _frontierFinder->getFrontiers();
+      std::vector<WeightedFrontier> wf = _frontierFinder->getWeightedFrontiers();
 
-      if(_frontierFinder->getFrontiers().size())
+      // keep ids of frontiers and take over scores of unchanged ones
+      _tracker->associate(wf, _frontierFinder->getSegments(), map);
+
+      if(wf.size())
+      {
+         // robot's pose at the time of the map, keep last known pose if tf has none
+         if(!this->lookupRobotPose(map->header.frame_id, _base_frame, map->header.stamp, _robot_pose))
+            ROS_WARN("ohm_frontier_exploration -> ranking frontiers with last known robot pose");
+
+         std::vector<geometry_msgs::Point> starts(1, _robot_pose.position);
+         for(unsigned int r=0 ; r<_team.size() ; r++)
+         {
+            if(!_team[r].simulated && !this->lookupRobotPose(map->header.frame_id, _team[r].name, map->header.stamp, _team[r].pose))
+               ROS_WARN("ohm_frontier_exploration -> using last known pose of %s", _team[r].name.c_str());
+            starts.push_back(_team[r].pose.position);
+         }
+
+         // path length depends on the whole map, not only on the frontier's surroundings, so it is never cached
+         const std::vector<unsigned char>* blocked = NULL;
+         if(_use_reachability)
+         {
+            // robot's center has to keep its radius to obstacles, except where it stands now
+            _inflation.compute(*map, _robot_radius);
+            for(unsigned int r=0 ; r<starts.size() ; r++)
+               _inflation.clear(starts[r], _robot_radius);
+            blocked = &_inflation.getMask();
+         }
+
+         // one wavefront from all robots
+         _distanceMap.compute(*map, starts, blocked);
+
+         // reachability and path length are those of the own robot, team members only take part in the allocation
+         if(_use_reachability)
+            this->removeUnreachableFrontiers(wf);
+
+         for(unsigned int i=0 ; i<wf.size() ; i++)
+            wf[i].path_cost = _distanceMap.getDistance(wf[i].frontier.position, 3, 0);
+         ROS_DEBUG("ohm_frontier_exploration -> %u of %u frontiers unchanged", _tracker->getNumCached(), (unsigned int)wf.size());
+
+         // count unknown cells visible from every frontier
+         _informationGain->evaluate(wf);
+         ROS_DEBUG("ohm_frontier_exploration -> information gain: %u cached, %u evaluated",
+                   _informationGain->getNumCached(), _informationGain->getNumEvaluated());
+      }
+
+      std::vector<int> assignment;
+      if(wf.size())
       {
          // look for best frontier
-         _frontierController->setWeightedFrontiers(_frontierFinder->getWeightedFrontiers());
-         _frontierController->findBestFrontier();
-         _frontierController->getWeightedFrontiers();
-         _frontiers = _frontierController->getWeightedFrontiers();
-         //this->publishFrontiers();
+         _frontierController->setWeightedFrontiers(wf);
+         _frontierController->findBestFrontier(_robot_pose);
+         wf = _frontierController->getWeightedFrontiers();
+
+         if(!_team.empty())
+         {
+            std::vector<geometry_msgs::Pose> poses(1, _robot_pose);
+            for(unsigned int r=0 ; r<_team.size() ; r++)
+               poses.push_back(_team[r].pose);
+            this->allocateFrontiers(wf, poses, assignment);
+         }
+      }
+
+      _tracker->update(wf);
+
+      // hand over results to service callbacks
+      boost::mutex::scoped_lock lock(_result_mutex);
+      _frontiers.swap(wf);
+      _assignment.swap(assignment);
+      _frontier_header = map->header;
+      _best_frontier   = _frontierController->getBestFrontier();
+
+      // own robot drives to its assigned frontier, so team members get different ones
+      if(!_assignment.empty() && _assignment[0] >= 0)
+      {
+         _best_frontier = _frontiers[_assignment[0]].frontier;
+      }
+      else if(!_frontiers.empty() && _frontiers.back().path_cost < 0.0f)
+      {
+         // without an assignment take the best frontier the own robot can reach, not one only a team member reaches
+         int best = static_cast<int>(_frontiers.size()) - 1;
+         while(best >= 0 && _frontiers[best].path_cost < 0.0f)
+            best--;
+         if(best >= 0)
+            _best_frontier = _frontiers[best].frontier;
+         else
+            ROS_WARN_THROTTLE(5.0, "ohm_frontier_exploration -> robot reaches none of the frontiers");
       }
    }
    else
@@ -137,7 +297,67 @@ void FrontierExplorationNode::findFrontiers(void)
 }
 
 
-void FrontierExplorationNode::publishFrontiers(void)
+bool FrontierExplorationNode::lookupRobotPose(const std::string& map_frame, const std::string& robot_frame,
+                                              const ros::Time& stamp, geometry_msgs::Pose& pose)
+{
+   tf::StampedTransform transform;
+   try {
+      // never wait for tf here, take latest transform if map is newer than tf buffer
+      const ros::Time time = _tf_listener.canTransform(map_frame, robot_frame, stamp) ? stamp : ros::Time(0);
+      _tf_listener.lookupTransform(map_frame, robot_frame, time, transform);
+   }
+   catch (tf::TransformException& ex) {
+      ROS_ERROR("%s",ex.what());
+      return false;
+   }
+
+   tf::poseTFToMsg(transform, pose);
+   return true;
+}
+
+
+void FrontierExplorationNode::allocateFrontiers(const std::vector<WeightedFrontier>& wf,
+                                                 const std::vector<geometry_msgs::Pose>& poses,
+                                                 std::vector<int>& assignment)
+{
+   // cost of a robot for a frontier is its path length, frontiers a robot can not reach are left out
+   std::vector<std::vector<float> > cost(poses.size(), std::vector<float>(wf.size(), -1.0f));
+   for(unsigned int r=0 ; r<poses.size() ; r++)
+   {
+      for(unsigned int f=0 ; f<wf.size() ; f++)
+         cost[r][f] = _distanceMap.getDistance(wf[f].frontier.position, 3, r);
+   }
+
+   const double sum = _allocator.allocate(cost, assignment);
+   ROS_DEBUG("ohm_frontier_exploration -> assigned frontiers to %u robots, sum of path lengths %.2f m",
+             (unsigned int)poses.size(), sum);
+}
+
+
+void FrontierExplorationNode::removeUnreachableFrontiers(std::vector<WeightedFrontier>& wf)
+{
+   const std::vector<std::vector<unsigned int> >& segments = _frontierFinder->getSegments();
+   if(segments.size() != wf.size())
+      return;
+
+   // a frontier is reachable if the own robot reaches one of its cells through non inflated free space
+   unsigned int kept = 0;
+   for(unsigned int i=0 ; i<wf.size() ; i++)
+   {
+      bool reachable = false;
+      for(unsigned int c=0 ; c<segments[i].size() && !reachable ; c++)
+         reachable = _distanceMap.isReached(segments[i][c], 0);
+
+      if(reachable)
+         wf[kept++] = wf[i];
+   }
+
+   ROS_DEBUG("ohm_frontier_exploration -> dropped %u unreachable frontiers", (unsigned int)wf.size() - kept);
+   wf.resize(kept);
+}
+
+
+void FrontierExplorationNode::publishFrontiers(const nav_msgs::MapMetaData& info)
 {
    // publish frontiers for rviz and further calculation
    static unsigned int seq = 0;
@@ -152,39 +372,151 @@ void FrontierExplorationNode::publishFrontiers(void)
 
    // publish message
    _frontier_pub.publish(frontierMarkers);
-   _frontier_grid_pub.publish(_frontierFinder->getFrontierLayer());
+
+   this->publishFrontierUpdate();
 
    // visualization
-   _viz.setFrontiers(        _frontierFinder->getFrontiers());
+   _viz.setFrontierCells(    _frontierFinder->getFrontierCells(), info);
    _viz.setBestFrontier(     _frontierController->getBestFrontier());
-   _viz.setWeightedFrontiers(_frontierController->getWeightedFrontiers());
+   _viz.setWeightedFrontiers(_frontiers);
    _viz.publish();
 }
 
 
-void FrontierExplorationNode::mapCallback(const nav_msgs::OccupancyGrid& map)
+void FrontierExplorationNode::publishFrontierUpdate(void)
 {
-   ROS_DEBUG_STREAM("received new map. ");
-   _frontierFinder->setMap(map);
+   const std::vector<unsigned int>& added   = _tracker->getAdded();
+   const std::vector<unsigned int>& changed = _tracker->getChanged();
+   const std::vector<unsigned int>& removed = _tracker->getRemoved();
 
-   if(1)//_mode == frontier::RUN)
+   if(added.empty() && changed.empty() && removed.empty())
+      return;
+
+   ohm_autonomy_msgs::FrontierUpdate update;
+   update.header  = _frontier_header;
+   update.removed = removed;
+
+   update.added.reserve(added.size());
+   for(unsigned int i=0 ; i<added.size() ; i++)
+      update.added.push_back(toMsg(_frontiers[added[i]]));
+
+   update.changed.reserve(changed.size());
+   for(unsigned int i=0 ; i<changed.size() ; i++)
+      update.changed.push_back(toMsg(_frontiers[changed[i]]));
+
+   _frontier_update_pub.publish(update);
+}
+
+
+void FrontierExplorationNode::mapCallback(const nav_msgs::OccupancyGrid::ConstPtr& map)
+{
+   ROS_DEBUG_STREAM("received new map. ");
    {
-      this->findFrontiers();
-      this->publishFrontiers();
+      boost::mutex::scoped_lock lock(_map_mutex);
+      if(_pending_map && _mode != frontier::STOP)
+         ++_dropped_maps;
+      _pending_map = map;
    }
-   else if(_mode == frontier::SINGLESHOT)
+   _map_condition.notify_one();
+}
+
+
+void FrontierExplorationNode::processMaps(void)
+{
+   while(ros::ok())
    {
-      this->findFrontiers();
-      this->publishFrontiers();
-      _mode = frontier::STOP;
+      nav_msgs::OccupancyGrid::ConstPtr map;
+      {
+         boost::mutex::scoped_lock lock(_map_mutex);
+         while((!_pending_map || _mode == frontier::STOP) && !_shutdown)
+         {
+            // wake up from time to time to notice shutdown of ros
+            if(!_map_condition.timed_wait(lock, boost::posix_time::milliseconds(100)) && !ros::ok())
+               return;
+         }
+         if(_shutdown)
+            return;
+
+         map.swap(_pending_map);
+
+         // single shot is done with this map
+         if(_mode == frontier::SINGLESHOT)
+            _mode = frontier::STOP;
+
+         if(_dropped_maps)
+         {
+            ROS_DEBUG("ohm_frontier_exploration -> skipped %u outdated maps", _dropped_maps);
+            _dropped_maps = 0;
+         }
+      }
+
+      {
+         boost::mutex::scoped_lock lock(_config_mutex);
+         if(_config_changed)
+         {
+            _frontierController->setConfig(_controller_config);
+            _config_changed = false;
+         }
+      }
+
+      _frontierFinder->setMap(map);
+      _informationGain->setMap(map);
+
+      this->findFrontiers(map);
+      this->publishFrontiers(map->info);
    }
 }
 
 bool FrontierExplorationNode::getFrontierServiceCB(ohm_autonomy_msgs::GetFrontierTarget::Request& req,
                                                    ohm_autonomy_msgs::GetFrontierTarget::Response& res)
 {
-   ROS_DEBUG_STREAM("service call: returning new frontier to: " << _frontierController->getBestFrontier());
-   res.target = _frontierController->getBestFrontier();
+   boost::mutex::scoped_lock lock(_result_mutex);
+   ROS_DEBUG_STREAM("service call: returning new frontier to: " << _best_frontier);
+   res.target = _best_frontier;
+   return true;
+}
+
+bool FrontierExplorationNode::getAllFrontierServiceCB(ohm_autonomy_msgs::GetFrontiers::Request&  req,
+                                                      ohm_autonomy_msgs::GetFrontiers::Response& res)
+{
+   boost::mutex::scoped_lock lock(_result_mutex);
+   const unsigned int k = (req.k && req.k < _frontiers.size()) ? req.k : _frontiers.size();
+
+   res.header = _frontier_header;
+   res.frontiers.reserve(k);
+
+   // frontiers are sorted by weight, best one is the last
+   for(unsigned int i=0 ; i<k ; i++)
+      res.frontiers.push_back(toMsg(_frontiers[_frontiers.size() - 1 - i]));
+
+   ROS_DEBUG_STREAM("service call: returning " << k << " of " << _frontiers.size() << " frontiers");
+   return true;
+}
+
+bool FrontierExplorationNode::getAssignmentServiceCB(ohm_autonomy_msgs::GetFrontierAssignment::Request&  req,
+                                                     ohm_autonomy_msgs::GetFrontierAssignment::Response& res)
+{
+   boost::mutex::scoped_lock lock(_result_mutex);
+   res.header = _frontier_header;
+
+   // own robot first, then team members in order of parameters
+   const unsigned int robots = _team.size() + 1;
+   res.robots.reserve(robots);
+   res.targets.resize(robots);
+   res.assigned.resize(robots, false);
+
+   res.robots.push_back(_base_frame);
+   for(unsigned int r=0 ; r<_team.size() ; r++)
+      res.robots.push_back(_team[r].name);
+
+   for(unsigned int r=0 ; r<robots && r<_assignment.size() ; r++)
+   {
+      if(_assignment[r] < 0) continue;
+      res.targets[r]  = toMsg(_frontiers[_assignment[r]]);
+      res.assigned[r] = true;
+   }
+
+   ROS_DEBUG_STREAM("service call: returning frontiers for " << robots << " robots");
    return true;
 }
 
@@ -198,22 +530,27 @@ bool FrontierExplorationNode::callback_srv_transmittTargets(
 {
    res.accepted = true;
 
-   if(req.action == req.START)
-   {
-      _mode = frontier::RUN;
-   }
-   else if(req.action == req.SINGLESHOT)
    {
-      _mode = frontier::SINGLESHOT;
-   }
-   else if(req.action == req.STOP)
-   {
-      _mode = frontier::STOP;
-   }
-   else
-   {
-      res.accepted = false;
+      // map received while stopped is kept, so worker starts without waiting for the next one
+      boost::mutex::scoped_lock lock(_map_mutex);
+      if(req.action == req.START)
+      {
+         _mode = frontier::RUN;
+      }
+      else if(req.action == req.SINGLESHOT)
+      {
+         _mode = frontier::SINGLESHOT;
+      }
+      else if(req.action == req.STOP)
+      {
+         _mode = frontier::STOP;
+      }
+      else
+      {
+         res.accepted = false;
+      }
    }
+   _map_condition.notify_one();
    ROS_INFO("ohm_frontier ->  callback NodeControll serivce: accept: %s", (res.accepted) ? "true" : "false");
 
    return true;
@@ -233,12 +570,15 @@ void callback(ohm_frontier_exploration::ExplorationConfig &config, uint32_t leve
    cfg.euclideanDistanceFactor = 0; //config.dist_factor;
    cfg.orientationFactor       = config.orientation_factor;
    cfg.sizeFactor              = 8.0; //config.size_factor;
+   cfg.maxEuclideanDistance    = config.max_dist_threshold;
+   cfg.gainFactor              = config.gain_factor;
 
 
    ROS_INFO_STREAM("changed configuration: "                              << std::endl <<
                    "distance factor :   "  << cfg.euclideanDistanceFactor << std::endl <<
                    "size factor:        "  << cfg.orientationFactor       << std::endl <<
-                   "orientation factor: "  << cfg.sizeFactor              << std::endl);
+                   "orientation factor: "  << cfg.sizeFactor              << std::endl <<
+                   "gain factor:        "  << cfg.gainFactor              << std::endl);
 
 
    autonohm::FrontierExplorationNode::getInstance()->setDynamicConfig(cfg);
@@ -13,14 +13,23 @@
 #include <nav_msgs/OccupancyGrid.h>
 
 #include <tf/transform_listener.h>
+
+#include <boost/thread.hpp>
 //#include <costmap_2d/costmap_2d_ros.h>
 
 #include "Frontier.h"
 #include "FrontierFinder.h"
 #include "Visualization.h"
 #include "FrontierController.h"
+#include "InformationGain.h"
+#include "DistanceMap.h"
+#include "Inflation.h"
+#include "FrontierAllocator.h"
+#include "FrontierTracker.h"
 
 #include "ohm_autonomy_msgs/GetFrontierTarget.h"
+#include "ohm_autonomy_msgs/GetFrontiers.h"
+#include "ohm_autonomy_msgs/GetFrontierAssignment.h"
 
 //trigger service
 #include "ohm_apps_msgs/NodeControl.h"
@@ -38,6 +47,17 @@ enum enumMode{
    SINGLESHOT,
    STOP
 };
+
+/**
+ * @struct  Robot
+ * @brief   Further robot of the team frontiers are shared with
+ */
+struct Robot
+{
+   std::string          name;                //!< frame of robot's footprint or name of simulated robot
+   bool                 simulated;           //!< pose is given by parameters and not looked up in tf
+   geometry_msgs::Pose  pose;                //!< last known pose in map frame
+};
 }
 
 /**
@@ -58,16 +78,20 @@ public:
    virtual ~FrontierExplorationNode(void);
 
    /**
-    * Function to spin ros node
+    * Function to spin ros node until shutdown. Callbacks are served by an
+    * asynchronous spinner, maps are processed in a separate worker thread.
     */
    void run(void);
 
    bool isInitialized(void);
 
+   /**
+    * Function to set configuration of frontier ranking.
+    * Takes effect with the next processed map.
+    * @param c
+    */
    void setDynamicConfig(FrontierControllerConfig c);
 
-   void setLoopRate(const double& looprate) { _rate = looprate; }
-
 private:
    /**
     * Private constructor for singleton pattern
@@ -81,21 +105,59 @@ private:
 
    /**
     * Function to search for frontiers
+    * @param map           current map
+    */
+   void findFrontiers(const nav_msgs::OccupancyGrid::ConstPtr& map);
+   /**
+    * Function to remove frontiers the own robot can not reach through non inflated free space.
+    * Uses distance map of current map, frontiers have to be in order of the Finder's segments.
+    * @param wf            frontiers of current map
     */
-   void findFrontiers(void);
+   void removeUnreachableFrontiers(std::vector<WeightedFrontier>& wf);
+   /**
+    * Worker thread processing always the latest received map. Sleeps while
+    * node is stopped, a START or SINGLESHOT request wakes it up at once.
+    */
+   void processMaps(void);
+   /**
+    * Function to get robot's pose in map frame from tf buffer without blocking.
+    * Falls back to the latest transform if there is none at the time of the map.
+    * @param map_frame     target frame
+    * @param stamp         time of the pose
+    * @param pose          resulting pose
+    * @return              true if a transform was available
+    */
+   bool lookupRobotPose(const std::string& map_frame, const std::string& robot_frame,
+                        const ros::Time& stamp, geometry_msgs::Pose& pose);
+   /**
+    * Function to assign a distinct frontier to every robot of the team, uses
+    * path lengths of distance map calculated from all robots
+    * @param wf            ranked frontiers
+    * @param poses         poses of all robots, own robot first
+    * @param assignment    index of frontier for every robot, -1 if none is left
+    */
+   void allocateFrontiers(const std::vector<WeightedFrontier>& wf,
+                          const std::vector<geometry_msgs::Pose>& poses,
+                          std::vector<int>& assignment);
    /**
     * Function to publish frontiers
+    * @param info          geometry of map the frontiers belong to
     */
-   void publishFrontiers(void);
+   void publishFrontiers(const nav_msgs::MapMetaData& info);
 
    void publishMarkers(void);
+   /**
+    * Function to publish frontiers which were added, changed or removed
+    */
+   void publishFrontierUpdate(void);
 
    // CALLBACK FUNCTIONS
    /**
-    * Callback function for map
+    * Callback function for map. Only keeps a reference to the map, a map
+    * which was not processed yet is replaced by the newer one.
     * @param map
     */
-   void mapCallback(const nav_msgs::OccupancyGrid& map);
+   void mapCallback(const nav_msgs::OccupancyGrid::ConstPtr& map);
 
    /**
     * Service callback to receive next frontier for navigation
@@ -106,13 +168,21 @@ private:
    bool getFrontierServiceCB(ohm_autonomy_msgs::GetFrontierTarget::Request&  req,
                              ohm_autonomy_msgs::GetFrontierTarget::Response& res);
    /**
-    * Service callback to return all frontiers
+    * Service callback to return the k best frontiers, best first
     * @param req
     * @param res
     * @return
     */
-   bool getAllFrontierServiceCB(ohm_autonomy_msgs::GetFrontierTarget::Request&  req,
-                                ohm_autonomy_msgs::GetFrontierTarget::Response& res);
+   bool getAllFrontierServiceCB(ohm_autonomy_msgs::GetFrontiers::Request&  req,
+                                ohm_autonomy_msgs::GetFrontiers::Response& res);
+   /**
+    * Service callback to return a distinct frontier for every robot of the team
+    * @param req
+    * @param res
+    * @return
+    */
+   bool getAssignmentServiceCB(ohm_autonomy_msgs::GetFrontierAssignment::Request&  req,
+                               ohm_autonomy_msgs::GetFrontierAssignment::Response& res);
 
    /**
     * Service to trigger the transmission of the frontiers
@@ -132,23 +202,51 @@ private:
 
    ros::Publisher                   _sub_map_pub;
    ros::Publisher                   _frontier_pub;
-   ros::Publisher                   _frontier_grid_pub;
    ros::Publisher                   _maker_pub;
+   ros::Publisher                   _frontier_update_pub;
 
    ros::ServiceServer               _best_target_service;
    ros::ServiceServer               _all_targets_service;
+   ros::ServiceServer               _assignment_service;
    ros::ServiceServer               _transmitt_targets_service;
 
-   std::vector<WeightedFrontier>    _frontiers;
+   tf::TransformListener            _tf_listener;           //!< long living tf buffer for robot's pose
+   std::string                      _base_frame;            //!< frame of robot's footprint
+   geometry_msgs::Pose              _robot_pose;            //!< last known pose of robot in map frame
+
+   std::vector<WeightedFrontier>    _frontiers;             //!< ranked frontiers, best one is the last
+   std_msgs::Header                 _frontier_header;       //!< header of map the frontiers belong to
+   Frontier                         _best_frontier;         //!< best frontier of last processed map
+   std::vector<int>                 _assignment;            //!< index of frontier for own robot and every team member
+   boost::mutex                     _result_mutex;          //!< guards results read by service callbacks
+
+   boost::thread                    _worker;                //!< thread processing maps
+   nav_msgs::OccupancyGrid::ConstPtr _pending_map;          //!< latest map not processed yet
+   unsigned int                     _dropped_maps;          //!< maps replaced before being processed
+   bool                             _shutdown;
+   boost::mutex                     _map_mutex;             //!< guards pending map, mode and shutdown flag
+   boost::condition_variable        _map_condition;
+
+   FrontierControllerConfig         _controller_config;     //!< config to be applied by worker
+   bool                             _config_changed;
+   boost::mutex                     _config_mutex;
 
    frontier::Finder*                _frontierFinder;
    frontier::Visualization          _viz;
+   frontier::InformationGain*       _informationGain;
+   frontier::DistanceMap            _distanceMap;
+   frontier::Inflation              _inflation;
+   frontier::FrontierAllocator      _allocator;
+   std::vector<frontier::Robot>     _team;                  //!< further robots sharing frontiers, empty for single robot
+   frontier::FrontierTracker*       _tracker;
    FrontierController*              _frontierController;
 
-   frontier::enumMode               _mode;
+   frontier::enumMode               _mode;                  //!< guarded by _map_mutex
 
    bool                             _is_initialized;        //!< flag to check if node is initialized
-   double                           _rate;                  //!< looprate to spin ros node
+   int                              _spinner_threads;       //!< threads serving callbacks
+   double                           _robot_radius;          //!< radius of robot for inflation of obstacles
+   bool                             _use_reachability;      //!< drop frontiers which can not be reached without touching inflated obstacles
 };
 
 } /* namespace autonohm */
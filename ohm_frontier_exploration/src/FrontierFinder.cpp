@@ -8,12 +8,52 @@
 #include "FrontierFinder.h"
 
 #include <tf/tf.h>
-#include <tf/LinearMath/Vector3.h>
 
 #include <math.h>       /* atan2 */
+#include <algorithm>
+#include <cassert>
+#include <limits>
 
 namespace autonohm {
 namespace frontier {
+
+namespace {
+/**
+ * Function to check if cell is free and has an unknown 4-neighbour
+ */
+inline bool isFrontierCell(const signed char* map, int x, int y, int w, int h)
+{
+   const int idx = y * w + x;
+   return (map[idx] == FREE) &&
+          (((x + 1 < w) && (map[idx + 1] == UNKNOWN))
+       ||  ((x > 0)     && (map[idx - 1] == UNKNOWN))
+       ||  ((y + 1 < h) && (map[idx + w] == UNKNOWN))
+       ||  ((y > 0)     && (map[idx - w] == UNKNOWN)));
+}
+
+/**
+ * @struct  SegmentMoments
+ * @brief   Sums over cells of a frontier segment for centroid and covariance
+ */
+struct SegmentMoments
+{
+   double n;
+   double sx, sy;                         //!< first moments in cells
+   double sxx, sxy, syy;                  //!< second moments in cells
+   double ux, uy;                         //!< sum of directions towards unknown space
+
+   SegmentMoments(void) : n(0.0), sx(0.0), sy(0.0), sxx(0.0), sxy(0.0), syy(0.0), ux(0.0), uy(0.0) { }
+
+   void add(double x, double y, double dx, double dy)
+   {
+      n   += 1.0;
+      sx  += x;      sy  += y;
+      sxx += x * x;  sxy += x * y;  syy += y * y;
+      ux  += dx;     uy  += dy;
+   }
+};
+}
+
 Finder::Finder(void) :
       _initialized(false)
 {
@@ -32,7 +72,7 @@ Finder::~Finder(void)
    // nothing to do
 }
 
-void Finder::setMap(const nav_msgs::OccupancyGrid& map)
+void Finder::setMap(const nav_msgs::OccupancyGrid::ConstPtr& map)
 {
    _map = map;
 }
@@ -48,255 +88,243 @@ void Finder::calculateFrontiers(void)
    // remove all old frontiers
    _frontiers.clear();
    _frontiers_weighted.clear();
-   _frontier_layer.cells.clear();
-
-   // set info to header
-   _frontier_layer.header.frame_id = "/map";
-   _frontier_layer.header.stamp    = ros::Time::now();
-   _frontier_layer.cell_height     = _map.info.resolution;
-   _frontier_layer.cell_width      = _map.info.resolution;
+   _segments.clear();
+   _frontier_cells.clear();
 
+   if(!_map || _map->data.empty() || _map->data.size() != _map->info.width * _map->info.height)
+      return;
 
    int idx;
-   const int w    = _map.info.width;
-   const int size = _map.info.height * w;
+   const int w    = _map->info.width;
+   const int h    = _map->info.height;
+   const int size = h * w;
 
-
-   // copy to tmp array
-   signed char* map = new signed char[size];
-   for(idx=0 ; idx<size ; idx++) {
-      map[idx] = _map.data[idx];
-   }
+   // map is shared with other subscribers, labels are kept in a separate buffer
+   const signed char* map = &_map->data[0];
 
    /*
     * Find all frontiers
     */
-   for (idx=0; idx<size; idx++)
+   const bool coarseToFine = (_config.pyramid_levels > 1);
+   if(coarseToFine)
    {
-      const bool valid_point = (map[idx] == FREE) ;
-
-      if ((valid_point  && map)
-                        && (((idx + 1 < size) && (map[idx + 1] == UNKNOWN))
-                        ||  ((idx - 1 >= 0)   && (map[idx - 1] == UNKNOWN))
-                        ||  ((idx + w < size) && (map[idx + w] == UNKNOWN))
-                        ||  ((idx - w >= 0)   && (map[idx - w] == UNKNOWN)))) {
-         _map.data[idx] = -128;
-         _frontier_layer.cells.push_back(this->getPointFromIndex(idx,
-                                                                 w,
-                                                                 _map.info.origin.position.x,
-                                                                 _map.info.origin.position.y,
-                                                                 _map.info.resolution));
-      }
-      else {
-         _map.data[idx] = -127;
-      }
-   }
-
-   std::cout << "-------------------- cells: " << _frontier_layer.cells.size() << std::endl;
-
-   // clean up frontiers on seperate rows of the map
-   idx = _map.info.height - 1;
-   for (unsigned int y = 0; y < _map.info.width; y++) {
-      _map.data[idx] = -127;
-      idx += _map.info.height;
+      _subsampler.setLevels(_config.pyramid_levels);
+      _subsampler.convert(*_map);
    }
 
-   // group frontiers
-   //int segment_id = 127;
-   std::vector<std::vector<FrontierPoint> > segments;
+   _labels.assign(size, -127);
 
-   for (int i = 0; i < size; i++)
+   if(coarseToFine && _subsampler.getNumLevels())
    {
-      if (_map.data[i] == -128)
-      {
-         std::vector<int> neighbors;
-         std::vector<FrontierPoint> segment;
-         neighbors.push_back(i);
-
-         while (neighbors.size() > 0)
-         {
-            idx = neighbors.back();
-            neighbors.pop_back();
-
-            _map.data[idx] = -127;//segment_id;
-
-            //ROS_INFO("OVER ORIENTATION : idx: %d , size: %d", idx, size);
-
-            tf::Vector3 orientation(0, 0, 0);
-            int c = 0;
-            if ((idx + 1 < size) && (map[idx+1] == UNKNOWN)) {
-               orientation += tf::Vector3(1, 0, 0); c++;
-            }
-            if ((idx-1 >= 0)   && (map[idx-1]   == UNKNOWN)) {
-               orientation += tf::Vector3(-1, 0, 0); c++;
-            }
-            if ((idx+w < size) && (map[idx+w]   == UNKNOWN)) {
-               orientation += tf::Vector3(0, 1, 0);  c++;
-            }
-            if ((idx-w >= 0)   && (map[idx-w]   == UNKNOWN)) {
-               orientation += tf::Vector3(0, -1, 0); c++;
-            }
+      // find blocks of free space next to unknown space on coarse level, refine only those
+      const unsigned int level = _subsampler.getNumLevels() - 1;
+      const unsigned int cw    = _subsampler.getWidth(level);
+      const int          block = 1 << level;
 
-            assert(c > 0);
+      std::vector<unsigned int> candidates;
+      _subsampler.getFrontierCandidates(level, candidates);
 
-            autonohm::FrontierPoint fp;
-            fp.idx         = idx;
-            fp.orientation = orientation / c;
-            segment.push_back(fp);
+      for(unsigned int i=0 ; i<candidates.size() ; i++)
+      {
+         const int x0 = (candidates[i] % cw) * block;
+         const int y0 = (candidates[i] / cw) * block;
+         const int x1 = std::min(x0 + block, w);
+         const int y1 = std::min(y0 + block, h);
+
+         for(int y=y0 ; y<y1 ; y++)
+            for(int x=x0 ; x<x1 ; x++)
+               if(isFrontierCell(map, x, y, w, h))
+                  this->markFrontierCell(y * w + x);
+      }
+   }
+   else
+   {
+      for(int y=0 ; y<h ; y++)
+         for(int x=0 ; x<w ; x++)
+            if(isFrontierCell(map, x, y, w, h))
+               this->markFrontierCell(y * w + x);
+   }
 
-            //ROS_INFO("OVER CHECKING NEIGBOURS");
+   ROS_DEBUG_STREAM("Found " << _frontier_cells.size() << " frontier cells. ");
 
-            // check all 8 neighbors
-            if (((idx - 1) > 0)                  && (_map.data[idx - 1]     == -128))
-               neighbors.push_back(idx - 1);
+   /*
+    * Group frontier cells to segments of 8-connected cells. Moments of every
+    * segment are summed up while labeling, so covariance needs no second pass.
+    */
+   std::vector<std::vector<unsigned int> > segments;
+   std::vector<SegmentMoments>             moments;
+   std::vector<unsigned int>               neighbors;
 
-            if (((idx + 1) < size)               && (_map.data[idx + 1]     == -128))
-               neighbors.push_back(idx + 1);
+   for (int i = 0; i < size; i++)
+   {
+      if (_labels[i] != -128)
+         continue;
 
-            if (((idx - w) > 0)                  && (_map.data[idx - w]     == -128))
-               neighbors.push_back(idx - w);
+      segments.push_back(std::vector<unsigned int>());
+      moments.push_back(SegmentMoments());
+      std::vector<unsigned int>& segment = segments.back();
+      SegmentMoments&            m       = moments.back();
 
-            if (((idx - w + 1) > 0)              && (_map.data[idx - w + 1] == -128))
-               neighbors.push_back(idx - w + 1);
+      _labels[i] = -127;
+      neighbors.push_back(i);
 
-            if (((idx - w - 1) > 0)              && (_map.data[idx - w - 1] == -128))
-               neighbors.push_back(idx - w - 1);
+      while (!neighbors.empty())
+      {
+         idx = neighbors.back();
+         neighbors.pop_back();
 
-            if (((idx + w) < size)               && (_map.data[idx + w]     == -128))
-               neighbors.push_back(idx + w);
+         const int x = idx % w;
+         const int y = idx / w;
 
-            if (((idx + w + 1) < size)           && (_map.data[idx + w + 1] == -128))
-               neighbors.push_back(idx + w + 1);
+         // direction towards unknown 4-neighbours
+         double ux = 0.0;
+         double uy = 0.0;
+         int    c  = 0;
+         if ((x + 1 < w) && (map[idx + 1] == UNKNOWN)) { ux += 1.0; c++; }
+         if ((x > 0)     && (map[idx - 1] == UNKNOWN)) { ux -= 1.0; c++; }
+         if ((y + 1 < h) && (map[idx + w] == UNKNOWN)) { uy += 1.0; c++; }
+         if ((y > 0)     && (map[idx - w] == UNKNOWN)) { uy -= 1.0; c++; }
 
-            if (((idx + w - 1) < size)           && (_map.data[idx + w - 1] == -128))
-               neighbors.push_back(idx + w - 1);
+         assert(c > 0);
 
-            //ROS_INFO("AFTER CHECKING NEIGBOURS");
+         m.add(x, y, ux / c, uy / c);
+         segment.push_back(idx);
 
+         // check all 8 neighbors, bounds prevent jumps between rows
+         for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, h - 1); ny++)
+         {
+            for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, w - 1); nx++)
+            {
+               const int n = ny * w + nx;
+               if (_labels[n] == -128)
+               {
+                  _labels[n] = -127;
+                  neighbors.push_back(n);
+               }
+            }
          }
-         segments.push_back(segment);
-         //ROS_INFO("-----------i: %d", i);
-         //segment_id--;
-         //std::cout << "-------------------Frontier: Segment id" << segment_id << std::endl;
-         //if (segment_id < -127)
-//         {
-//            std::cout << "-------------------> Frontier ------------> breake segment ID " << segment_id << std::endl;
-//            break;
-//         }
       }
    }
 
-
-   delete [] map;                            // clean up of map
-
-
-
-   //int num_segments = 127 - segment_id;
-   //if (num_segments <= 0)
-   //   return;
-
    if(!segments.size())
       return;
 
 
    ROS_DEBUG_STREAM("Found " << segments.size() << " frontieres. ");
 
+   const double resolution = _map->info.resolution;
 
-   for (int i=0; i < segments.size(); i++)
+   for (unsigned int i=0; i < segments.size(); i++)
    {
+      const SegmentMoments& m = moments[i];
 
-      std::vector<FrontierPoint>& segment = segments[i];
-      uint fontierCells                   = segment.size();
+      /*
+       * Principal axes from covariance of cells
+       */
+      const double cx   = m.sx / m.n;
+      const double cy   = m.sy / m.n;
+      const double a    = m.sxx / m.n - cx * cx;
+      const double b    = m.sxy / m.n - cx * cy;
+      const double c    = m.syy / m.n - cy * cy;
+      const double root = std::sqrt(0.25 * (a - c) * (a - c) + b * b);
+      const double l1   = 0.5 * (a + c) + root;               // variance along principal axis
+      const double l2   = std::max(0.5 * (a + c) - root, 0.0); // variance across principal axis
+
+      // a straight line of n cells has a variance of (n^2 - 1) / 12
+      const double span = std::sqrt(12.0 * std::max(l1, 0.0) + 1.0);
 
       /*
        * Size check: can the robot pass the found frontier
        */
-      if (fontierCells * _map.info.resolution < _config.robot_radius )
-      {
+      if (span * resolution < _config.robot_radius)
          continue;
-      }
-      else
-      {
-         float x = 0;
-         float y = 0;
-         tf::Vector3 d(0, 0, 0);
-         for (unsigned int j = 0; j < fontierCells; j++) {
-            d += segment[j].orientation;
-
-            unsigned int cellIdx = segment[j].idx;
-            geometry_msgs::Point p = this->getPointFromIndex(cellIdx, _map.info.width);
-            x += p.x;
-            y += p.y;
 
-         }
-
-         d = d / fontierCells;
+      // frontier faces unknown space, normal of principal axis is only stable for elongated frontiers
+      const double ux  = m.ux / m.n;
+      const double uy  = m.uy / m.n;
+      double       yaw = std::atan2(uy, ux);
+      if (l1 > 2.0 * l2)
+      {
+         const double axis = 0.5 * std::atan2(2.0 * b, a - c);
+         const double nx   = -std::sin(axis);
+         const double ny   =  std::cos(axis);
+         yaw = (nx * ux + ny * uy < 0.0) ? std::atan2(-ny, -nx) : std::atan2(ny, nx);
+      }
 
-         Frontier f;
-         f.position.x   = _map.info.origin.position.x + _map.info.resolution * (x / fontierCells);
-         f.position.y   = _map.info.origin.position.y + _map.info.resolution * (y / fontierCells);
-         f.position.z   = 0.0;
-         f.orientation  = tf::createQuaternionMsgFromYaw(std::atan2(d.y(), d.x()));
+      Frontier f;
+      this->placeStandoff(segments[i], cx, cy, yaw, f);
 
-         this->optimizeFrontierIfInUnknown(f);
+      _frontiers.push_back(f);
 
-         _frontiers.push_back(f);
+      WeightedFrontier wf;
+      wf.frontier  = f;
+      wf.id        = 0;
+      wf.size      = span;
+      wf.gain      = 0.0f;
+      wf.path_cost = -1.0f;
+      wf.cached    = false;
+      _frontiers_weighted.push_back(wf);
 
-         WeightedFrontier wf;
-         wf.frontier = f;
-         wf.size     = fontierCells; // * _map.info.resolution;
-         _frontiers_weighted.push_back(wf);
-      }
+      // cells for association with frontiers of last map
+      _segments.push_back(std::vector<unsigned int>());
+      _segments.back().swap(segments[i]);
+      std::sort(_segments.back().begin(), _segments.back().end());
    }
 }
 
 
-geometry_msgs::Point Finder::getPointFromIndex(unsigned int idx, unsigned int width,
-                                                       float originX,    float originY,
-                                                       float resolution)
+void Finder::markFrontierCell(unsigned int idx)
 {
-   geometry_msgs::Point p;
-   p.x = static_cast<float>(idx % width) + originX + (_map.info.resolution / 2.0f);
-   p.y = static_cast<float>(idx / width) + originY + (_map.info.resolution / 2.0f);
-   p.z = 0;
-
-   return p;
+   _labels[idx] = -128;
+   _frontier_cells.push_back(idx);
 }
 
 
-
-void Finder::optimizeFrontierIfInUnknown(Frontier& frontier)
+void Finder::placeStandoff(const std::vector<unsigned int>& cells, double cx, double cy, double yaw,
+                           Frontier& frontier)
 {
-   // check if frontier is in unknown terrain
-   // get index of frontier position
-   unsigned int x = (frontier.position.x - _map.info.origin.position.x) / _map.info.resolution + 0.555;
-   unsigned int y = (frontier.position.y - _map.info.origin.position.y) / _map.info.resolution + 0.555;
-
-
-   unsigned int idx = x*_map.info.width + y;
-   //ROS_INFO("x: %d, y = %d  ,idx = %d",(int)x, (int)y,(int)idx);
-
-   ///@todo make this function recursive
-
-
-   //if(_map.data[idx] == UNKNOWN)
+   const int    w          = _map->info.width;
+   const int    h          = _map->info.height;
+   const double resolution = _map->info.resolution;
+   const signed char* map  = &_map->data[0];
+
+   // centroid of curved frontiers is not on the frontier, take closest frontier cell which is free for sure
+   unsigned int anchor = cells[0];
+   double       best   = std::numeric_limits<double>::max();
+   for (unsigned int i = 0; i < cells.size(); i++)
    {
-      //ROS_INFO("idx is Unkown : idx: %d", (int)idx);
-      // coorect position based on orientation
-      double yaw = tf::getYaw(frontier.orientation);
-
-
-
-      frontier.position.x -= 0.2*cos(yaw);
-      frontier.position.y -= 0.2*sin(yaw);
+      const double dx = static_cast<double>(cells[i] % w) - cx;
+      const double dy = static_cast<double>(cells[i] / w) - cy;
+      if (dx * dx + dy * dy < best)
+      {
+         best   = dx * dx + dy * dy;
+         anchor = cells[i];
+      }
    }
 
+   // move away from unknown space in steps of half a cell, stop in front of first cell not free
+   const double dx    = -std::cos(yaw);
+   const double dy    = -std::sin(yaw);
+   const int    steps = static_cast<int>(2.0 * _config.standoff_distance / resolution + 0.5);
+   double x = static_cast<double>(anchor % w) + 0.5;
+   double y = static_cast<double>(anchor / w) + 0.5;
 
+   for (int i = 1; i <= steps; i++)
+   {
+      const double nx = x + 0.5 * dx;
+      const double ny = y + 0.5 * dy;
+      if (nx < 0.0 || ny < 0.0 || nx >= w || ny >= h)
+         break;
+      if (map[static_cast<int>(ny) * w + static_cast<int>(nx)] != FREE)
+         break;
+      x = nx;
+      y = ny;
+   }
 
-   // correct frontier
-
-
-
+   frontier.position.x  = _map->info.origin.position.x + x * resolution;
+   frontier.position.y  = _map->info.origin.position.y + y * resolution;
+   frontier.position.z  = 0.0;
+   frontier.orientation = tf::createQuaternionMsgFromYaw(yaw);
 }
 
 
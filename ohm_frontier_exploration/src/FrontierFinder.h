@@ -10,9 +10,9 @@
 
 // ros includes
 #include "nav_msgs/OccupancyGrid.h"
-#include "nav_msgs/GridCells.h"
 
 #include "Frontier.h"
+#include "MapSubsampler.h"
 
 // std includes
 #include <ostream>
@@ -38,6 +38,10 @@ struct FinderConfig
 
    double max_search_radius;               //!< search radius around robot for frontier search can be used to save computation cost
 
+   int    pyramid_levels;                  //!< levels of map pyramid for coarse to fine search, 1 searches full map
+
+   double standoff_distance;               //!< distance of frontier pose from unknown space into free space
+
 };
 
 //friend std::ostream& operator<<(std::ostream &output, const FinderConfig &c)
@@ -92,7 +96,7 @@ public:
     * Function to set map for frontier estimation
     * @param map
     */
-   void setMap(const nav_msgs::OccupancyGrid& map);
+   void setMap(const nav_msgs::OccupancyGrid::ConstPtr& map);
    /**
     * Function to set configuration
     * @param config
@@ -114,10 +118,17 @@ public:
    std::vector<WeightedFrontier> getWeightedFrontiers(void) { return _frontiers_weighted; }
 
    /**
-    * Function to get frontier layer for debugging
+    * Function to get cells of weighted frontiers, sorted cell indices in
+    * same order as weighted frontiers
+    * @return
+    */
+   const std::vector<std::vector<unsigned int> >& getSegments(void) const { return _segments; }
+
+   /**
+    * Function to get indices of all frontier cells for debugging
     * @return
     */
-   nav_msgs::GridCells getFrontierLayer(void)               { return _frontier_layer; }
+   const std::vector<unsigned int>& getFrontierCells(void) const { return _frontier_cells; }
 
 
    /**
@@ -132,35 +143,40 @@ public:
 
 private:
    /**
-    * Function to convert index to coordinate
+    * Function to label cell as frontier and add it to frontier cells
     * @param idx           index of cell
-    * @param width         width of whole map
-    * @param originX       origin of map (x coordinate)
-    * @param originY       origin of map (y coordinate)
-    * @return
     */
-   geometry_msgs::Point getPointFromIndex(unsigned int idx, unsigned int width,
-                                          float originX = 0.0f, float originY = 0.0f,
-                                          float resolution = 1.0);
+   void markFrontierCell(unsigned int idx);
 
    /**
-    * Function to optimize frontier, which could be in unknown terrain.
-    * This is necessary, because the path planner.
-    * @param frontier
+    * Function to place frontier pose in free space, so the path planner does not
+    * get a goal in unknown terrain. Starts at the frontier cell closest to the
+    * centroid and moves against the frontier's direction by the standoff distance
+    * as long as cells are free.
+    * @param cells         cells of frontier
+    * @param cx            centroid of frontier in cells (x coordinate)
+    * @param cy            centroid of frontier in cells (y coordinate)
+    * @param yaw           direction of frontier towards unknown space
+    * @param frontier      resulting pose, always in a free cell
     */
-   void optimizeFrontierIfInUnknown(Frontier& frontier);
+   void placeStandoff(const std::vector<unsigned int>& cells, double cx, double cy, double yaw,
+                      Frontier& frontier);
 
 
 
 
    bool                             _initialized;
 
-   nav_msgs::OccupancyGrid          _map;                //!< map for exploration
+   nav_msgs::OccupancyGrid::ConstPtr _map;               //!< map for exploration, shared and never modified
+   std::vector<signed char>         _labels;             //!< frontier labels of cells
    FinderConfig                     _config;             //!< config for exploration
    std::vector<Frontier>            _frontiers;          //!< container for found frontiers
    std::vector<WeightedFrontier>    _frontiers_weighted; //!< weighted frontiers
+   std::vector<std::vector<unsigned int> > _segments;    //!< cells of weighted frontiers
+
+   std::vector<unsigned int>        _frontier_cells;     //!< indices of frontier cells for debugging
 
-   nav_msgs::GridCells              _frontier_layer;     //!< layer for debugging
+   MapSubsampler                    _subsampler;         //!< pyramid for coarse to fine search
 };
 
 } /* namespace frontier */
@@ -0,0 +1,272 @@
+/*
+ * FrontierTracker.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "FrontierTracker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+const double POSITION_EPS = 0.01;     //!< movement of a frontier in meters to be reported as change
+const float  VALUE_EPS    = 1e-3f;
+
+/**
+ * @struct Match
+ */
+struct Match
+{
+   double       dist;
+   unsigned int current;
+   unsigned int last;
+
+   bool operator<(const Match& m) const { return dist < m.dist; }
+};
+
+/**
+ * Function to check if cell indices of two maps can be compared
+ */
+bool sameGeometry(const nav_msgs::OccupancyGrid& a, const nav_msgs::OccupancyGrid& b)
+{
+   return (a.info.width                == b.info.width)
+       && (a.info.height               == b.info.height)
+       && (a.info.resolution           == b.info.resolution)
+       && (a.info.origin.position.x    == b.info.origin.position.x)
+       && (a.info.origin.position.y    == b.info.origin.position.y)
+       && (a.data.size()               == b.data.size());
+}
+}
+
+namespace autonohm {
+namespace frontier {
+
+FrontierTracker::FrontierTracker(double max_match_dist, double margin) :
+      _max_match_dist(max_match_dist)
+    , _margin(margin)
+    , _next_id(0)
+    , _num_cached(0)
+{
+
+}
+
+FrontierTracker::~FrontierTracker(void)
+{
+   // nothing to do
+}
+
+void FrontierTracker::associate(std::vector<WeightedFrontier>& wf,
+                                const std::vector<std::vector<unsigned int> >& segments,
+                                const nav_msgs::OccupancyGrid::ConstPtr& map)
+{
+   _num_cached = 0;
+   if(!map || segments.size() != wf.size())
+      return;
+
+   const bool overlap = _last_map && sameGeometry(*_last_map, *map);
+   std::vector<Match> matches;
+
+   if(overlap)
+   {
+      // count common cells with frontiers of last map, largest overlap is matched first
+      std::map<unsigned int, unsigned int> common;
+      for(unsigned int i=0 ; i<segments.size() ; i++)
+      {
+         common.clear();
+         for(unsigned int c=0 ; c<segments[i].size() ; c++)
+         {
+            const int j = _owner[segments[i][c]];
+            if(j >= 0) common[j]++;
+         }
+
+         for(std::map<unsigned int, unsigned int>::const_iterator it=common.begin() ; it!=common.end() ; ++it)
+         {
+            Match m;
+            m.dist    = -static_cast<double>(it->second);
+            m.current = i;
+            m.last    = it->first;
+            matches.push_back(m);
+         }
+      }
+      std::sort(matches.begin(), matches.end());
+   }
+
+   std::vector<bool> currentMatched(wf.size(),         false);
+   std::vector<bool> lastMatched(   _last_assoc.size(), false);
+   std::vector<int>  matchOf(       wf.size(),         -1);
+
+   for(unsigned int m=0 ; m<matches.size() ; m++)
+   {
+      const unsigned int i = matches[m].current;
+      const unsigned int j = matches[m].last;
+      if(currentMatched[i] || lastMatched[j])
+         continue;
+      currentMatched[i] = true;
+      lastMatched[j]    = true;
+      matchOf[i]        = j;
+   }
+
+   // frontiers without common cells keep the id of the closest one
+   matches.clear();
+   const double maxDist2 = _max_match_dist * _max_match_dist;
+   for(unsigned int i=0 ; i<wf.size() ; i++)
+   {
+      if(currentMatched[i]) continue;
+      for(unsigned int j=0 ; j<_last_assoc.size() ; j++)
+      {
+         if(lastMatched[j]) continue;
+
+         const double dx    = wf[i].frontier.position.x - _last_assoc[j].frontier.position.x;
+         const double dy    = wf[i].frontier.position.y - _last_assoc[j].frontier.position.y;
+         const double dist2 = dx * dx + dy * dy;
+         if(dist2 <= maxDist2)
+         {
+            Match m;
+            m.dist    = dist2;
+            m.current = i;
+            m.last    = j;
+            matches.push_back(m);
+         }
+      }
+   }
+   std::sort(matches.begin(), matches.end());
+
+   for(unsigned int m=0 ; m<matches.size() ; m++)
+   {
+      const unsigned int i = matches[m].current;
+      const unsigned int j = matches[m].last;
+      if(currentMatched[i] || lastMatched[j])
+         continue;
+      currentMatched[i] = true;
+      lastMatched[j]    = true;
+      matchOf[i]        = j;
+   }
+
+   for(unsigned int i=0 ; i<wf.size() ; i++)
+   {
+      wf[i].cached = false;
+
+      if(matchOf[i] < 0)
+      {
+         wf[i].id = _next_id++;
+         continue;
+      }
+
+      const unsigned int j = matchOf[i];
+      wf[i].id = _last_assoc[j].id;
+
+      // gain only depends on the frontier's cells and the map around it, path cost depends on the whole map
+      if(overlap && (segments[i] == _last_cells[j]) && this->isUnchanged(segments[i], *map))
+      {
+         std::map<unsigned int, unsigned int>::const_iterator last = _last_index.find(wf[i].id);
+         if(last != _last_index.end())
+         {
+            wf[i].gain   = _last[last->second].gain;
+            wf[i].cached = true;
+            _num_cached++;
+         }
+      }
+   }
+
+   // remember cells of frontiers for next map
+   if(overlap)
+   {
+      for(unsigned int j=0 ; j<_last_cells.size() ; j++)
+         for(unsigned int c=0 ; c<_last_cells[j].size() ; c++)
+            _owner[_last_cells[j][c]] = -1;
+   }
+   else
+   {
+      _owner.assign(map->data.size(), -1);
+   }
+
+   for(unsigned int i=0 ; i<segments.size() ; i++)
+      for(unsigned int c=0 ; c<segments[i].size() ; c++)
+         _owner[segments[i][c]] = i;
+
+   _last_cells = segments;
+   _last_assoc = wf;
+   _last_map   = map;
+}
+
+
+void FrontierTracker::update(const std::vector<WeightedFrontier>& wf)
+{
+   _added.clear();
+   _changed.clear();
+   _removed.clear();
+
+   std::map<unsigned int, unsigned int> index;
+   for(unsigned int i=0 ; i<wf.size() ; i++)
+   {
+      index[wf[i].id] = i;
+
+      std::map<unsigned int, unsigned int>::const_iterator last = _last_index.find(wf[i].id);
+      if(last == _last_index.end())
+         _added.push_back(i);
+      else if(differs(wf[i], _last[last->second]))
+         _changed.push_back(i);
+   }
+
+   for(unsigned int j=0 ; j<_last.size() ; j++)
+   {
+      if(!index.count(_last[j].id))
+         _removed.push_back(_last[j].id);
+   }
+
+   _last = wf;
+   _last_index.swap(index);
+}
+
+
+bool FrontierTracker::isUnchanged(const std::vector<unsigned int>& cells, const nav_msgs::OccupancyGrid& map) const
+{
+   if(&map == _last_map.get())
+      return true;
+
+   const int w = map.info.width;
+   const int h = map.info.height;
+
+   // bounding box of cells grown by margin
+   int x0 = w, y0 = h, x1 = -1, y1 = -1;
+   for(unsigned int c=0 ; c<cells.size() ; c++)
+   {
+      const int x = cells[c] % w;
+      const int y = cells[c] / w;
+      x0 = std::min(x0, x);
+      x1 = std::max(x1, x);
+      y0 = std::min(y0, y);
+      y1 = std::max(y1, y);
+   }
+
+   const int margin = std::ceil(_margin / map.info.resolution);
+   x0 = std::max(x0 - margin, 0);
+   y0 = std::max(y0 - margin, 0);
+   x1 = std::min(x1 + margin, w - 1);
+   y1 = std::min(y1 + margin, h - 1);
+
+   for(int y=y0 ; y<=y1 ; y++)
+   {
+      if(std::memcmp(&map.data[y * w + x0], &_last_map->data[y * w + x0], x1 - x0 + 1))
+         return false;
+   }
+   return true;
+}
+
+
+bool FrontierTracker::differs(const WeightedFrontier& a, const WeightedFrontier& b)
+{
+   return (std::abs(a.frontier.position.x    - b.frontier.position.x)    > POSITION_EPS)
+       || (std::abs(a.frontier.position.y    - b.frontier.position.y)    > POSITION_EPS)
+       || (std::abs(a.frontier.orientation.z - b.frontier.orientation.z) > VALUE_EPS)
+       || (std::abs(a.frontier.orientation.w - b.frontier.orientation.w) > VALUE_EPS)
+       || (std::abs(a.size      - b.size)      > VALUE_EPS)
+       || (std::abs(a.gain      - b.gain)      > VALUE_EPS)
+       || (std::abs(a.weight    - b.weight)    > VALUE_EPS)
+       || (std::abs(a.path_cost - b.path_cost) > POSITION_EPS);
+}
+
+} /* namespace frontier */
+} /* namespace autonohm */
@@ -0,0 +1,133 @@
+/*
+ * FrontierTracker.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef OHM_FRONTIER_EXPLORATION_SRC_FRONTIERTRACKER_H_
+#define OHM_FRONTIER_EXPLORATION_SRC_FRONTIERTRACKER_H_
+
+#include <nav_msgs/OccupancyGrid.h>
+
+#include "Frontier.h"
+
+#include <map>
+#include <vector>
+
+/**
+ * @namespace autonohm
+ */
+namespace autonohm {
+
+namespace frontier {
+
+/**
+ * @class   FrontierTracker
+ * @date    2026-10-19
+ *
+ * @brief   Gives frontiers ids which stay the same over map updates and
+ *          reports which frontiers were added, changed or removed.
+ *
+ * A frontier keeps the id of the frontier of the last update it shares most
+ * cells with. Frontiers without common cells fall back to the closest
+ * frontier within the matching distance. If the cells of a frontier and the
+ * map around it did not change, its information gain of the last update is
+ * taken over.
+ */
+class FrontierTracker
+{
+public:
+   /**
+    * Constructor
+    * @param max_match_dist      maximum distance in meters between two poses of the same frontier
+    * @param margin              distance in meters around a frontier which has to be unchanged to reuse its scores
+    */
+   FrontierTracker(double max_match_dist, double margin);
+   /**
+    * Default destructor
+    */
+   virtual ~FrontierTracker(void);
+
+   // SETTERS
+   /**
+    * Function to set maximum distance between two poses of the same frontier
+    * @param dist
+    */
+   void setMatchDistance(double dist)                             { _max_match_dist = dist; }
+   /**
+    * Function to set distance around a frontier which has to be unchanged to reuse its scores
+    * @param margin
+    */
+   void setMargin(double margin)                                  { _margin = margin; }
+
+   // GETTERS
+   /**
+    * Function to get indices of frontiers which are new in last update
+    * @return
+    */
+   const std::vector<unsigned int>& getAdded(void) const          { return _added; }
+   /**
+    * Function to get indices of tracked frontiers which changed in last update
+    * @return
+    */
+   const std::vector<unsigned int>& getChanged(void) const        { return _changed; }
+   /**
+    * Function to get ids of frontiers which disappeared in last update
+    * @return
+    */
+   const std::vector<unsigned int>& getRemoved(void) const        { return _removed; }
+   /**
+    * Function to get number of frontiers which took over scores in last association
+    * @return
+    */
+   unsigned int getNumCached(void) const                          { return _num_cached; }
+
+   // PROCESSING
+   /**
+    * Function to assign ids to frontiers of a new map and to take over
+    * scores of unchanged frontiers
+    * @param wf            frontiers of current map, ids and cached scores are set
+    * @param segments      sorted cell indices of every frontier
+    * @param map           map the frontiers were found in
+    */
+   void associate(std::vector<WeightedFrontier>& wf,
+                  const std::vector<std::vector<unsigned int> >& segments,
+                  const nav_msgs::OccupancyGrid::ConstPtr& map);
+   /**
+    * Function to report changes of ranked frontiers against last update
+    * @param wf            frontiers of current map with ids from associate()
+    */
+   void update(const std::vector<WeightedFrontier>& wf);
+
+private:
+   /**
+    * Function to check if a tracked frontier differs from its last state
+    */
+   static bool differs(const WeightedFrontier& a, const WeightedFrontier& b);
+   /**
+    * Function to check if cells around a segment are the same in both maps
+    */
+   bool isUnchanged(const std::vector<unsigned int>& cells, const nav_msgs::OccupancyGrid& map) const;
+
+   double                        _max_match_dist;
+   double                        _margin;
+   unsigned int                  _next_id;
+   unsigned int                  _num_cached;
+
+   nav_msgs::OccupancyGrid::ConstPtr         _last_map;       //!< map of last association
+   std::vector<std::vector<unsigned int> >   _last_cells;     //!< cells of frontiers of last association
+   std::vector<WeightedFrontier>             _last_assoc;     //!< frontiers of last association
+   std::vector<int>                          _owner;          //!< index of last frontier for every cell, -1 if none
+
+   std::vector<WeightedFrontier>             _last;           //!< frontiers of last update
+   std::map<unsigned int, unsigned int>      _last_index;     //!< index in last update by id
+   std::vector<unsigned int>     _added;
+   std::vector<unsigned int>     _changed;
+   std::vector<unsigned int>     _removed;
+};
+
+} /* namespace frontier */
+
+} /* namespace autonohm */
+
+#endif /* OHM_FRONTIER_EXPLORATION_SRC_FRONTIERTRACKER_H_ */
@@ -0,0 +1,160 @@
+/*
+ * Inflation.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "Inflation.h"
+
+#include "FrontierFinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+/**
+ * Function to get intersection of parabolas with apexes at q and p
+ * @param f             height of apexes
+ */
+inline double intersect(const unsigned short* f, int q, int p)
+{
+   const double fq = static_cast<double>(f[q]) * f[q] + static_cast<double>(q) * q;
+   const double fp = static_cast<double>(f[p]) * f[p] + static_cast<double>(p) * p;
+   return (fq - fp) / (2.0 * (q - p));
+}
+}
+
+namespace autonohm {
+namespace frontier {
+
+Inflation::Inflation(void) :
+      _width(0)
+    , _height(0)
+    , _resolution(0.0f)
+    , _origin_x(0.0)
+    , _origin_y(0.0)
+{
+
+}
+
+Inflation::~Inflation(void)
+{
+   // nothing to do
+}
+
+void Inflation::compute(const nav_msgs::OccupancyGrid& map, double radius)
+{
+   _width      = map.info.width;
+   _height     = map.info.height;
+   _resolution = map.info.resolution;
+   _origin_x   = map.info.origin.position.x;
+   _origin_y   = map.info.origin.position.y;
+
+   const int w = _width;
+   const int h = _height;
+
+   _mask.assign(map.data.size(), 0);
+   if(map.data.size() != _width * _height || !w || !h || _resolution <= 0.0f)
+      return;
+
+   // distances above radius are not of interest
+   const double         r   = radius / _resolution;
+   const double         r2  = r * r;
+   const unsigned short cap = static_cast<unsigned short>(std::min(std::floor(r) + 1.0,
+                                          static_cast<double>(std::numeric_limits<unsigned short>::max() - 1)));
+
+   /*
+    * distance to closest obstacle along columns, two sweeps over rows keep memory access linear
+    */
+   _column.resize(map.data.size());
+   const signed char* data = &map.data[0];
+   for(int x=0 ; x<w ; x++)
+      _column[x] = (data[x] > FREE) ? 0 : cap;
+
+   for(int y=1 ; y<h ; y++)
+   {
+      const signed char*    row   = data + y * w;
+      const unsigned short* above = &_column[(y - 1) * w];
+      unsigned short*       col   = &_column[y * w];
+      for(int x=0 ; x<w ; x++)
+         col[x] = (row[x] > FREE) ? 0 : std::min<unsigned short>(above[x] + 1, cap);
+   }
+
+   for(int y=h-2 ; y>=0 ; y--)
+   {
+      const unsigned short* below = &_column[(y + 1) * w];
+      unsigned short*       col   = &_column[y * w];
+      for(int x=0 ; x<w ; x++)
+         col[x] = std::min<unsigned short>(col[x], below[x] + 1);
+   }
+
+   /*
+    * lower envelope of parabolas along rows
+    */
+   _v.resize(w);
+   _z.resize(w + 1);
+   const double inf = std::numeric_limits<double>::max();
+
+   for(int y=0 ; y<h ; y++)
+   {
+      const unsigned short* col  = &_column[y * w];
+      unsigned char*        mask = &_mask[y * w];
+
+      // rows far away from obstacles are skipped
+      if(*std::min_element(col, col + w) >= cap)
+         continue;
+
+      int k = 0;
+      _v[0] = 0;
+      _z[0] = -inf;
+      _z[1] =  inf;
+
+      for(int q=1 ; q<w ; q++)
+      {
+         // z[0] is -inf, so search ends at the first apex
+         double s = intersect(col, q, _v[k]);
+         while(s <= _z[k])
+            s = intersect(col, q, _v[--k]);
+
+         k++;
+         _v[k]     = q;
+         _z[k]     = s;
+         _z[k + 1] = inf;
+      }
+
+      k = 0;
+      for(int x=0 ; x<w ; x++)
+      {
+         while(_z[k + 1] < x)
+            k++;
+         const double dx = x - _v[k];
+         const double d  = dx * dx + static_cast<double>(col[_v[k]]) * col[_v[k]];
+         mask[x] = (d <= r2);
+      }
+   }
+}
+
+
+void Inflation::clear(const geometry_msgs::Point& p, double radius)
+{
+   if(_mask.empty())
+      return;
+
+   const int   px = std::floor((p.x - _origin_x) / _resolution);
+   const int   py = std::floor((p.y - _origin_y) / _resolution);
+   const int   r  = std::ceil(radius / _resolution);
+   const float r2 = (radius / _resolution) * (radius / _resolution);
+
+   for(int y=std::max(py - r, 0) ; y<=std::min(py + r, static_cast<int>(_height) - 1) ; y++)
+   {
+      for(int x=std::max(px - r, 0) ; x<=std::min(px + r, static_cast<int>(_width) - 1) ; x++)
+      {
+         if((x - px) * (x - px) + (y - py) * (y - py) <= r2)
+            _mask[y * _width + x] = 0;
+      }
+   }
+}
+
+} /* namespace frontier */
+} /* namespace autonohm */
@@ -0,0 +1,83 @@
+/*
+ * Inflation.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef OHM_FRONTIER_EXPLORATION_SRC_INFLATION_H_
+#define OHM_FRONTIER_EXPLORATION_SRC_INFLATION_H_
+
+#include <nav_msgs/OccupancyGrid.h>
+#include <geometry_msgs/Point.h>
+
+#include <vector>
+
+/**
+ * @namespace autonohm
+ */
+namespace autonohm {
+
+namespace frontier {
+
+/**
+ * @class   Inflation
+ * @date    2026-10-19
+ *
+ * @brief   Marks all cells closer to an obstacle than the robot's radius.
+ *
+ * Uses the euclidean distance transform of Felzenszwalb and Huttenlocher:
+ * distances along columns followed by the lower envelope of parabolas along
+ * rows, both linear in the number of cells. Distances are clipped above the
+ * radius, so a cell needs only two bytes.
+ */
+class Inflation
+{
+public:
+   /**
+    * Default constructor
+    */
+   Inflation(void);
+   /**
+    * Default destructor
+    */
+   virtual ~Inflation(void);
+
+   // PROCESSING
+   /**
+    * Function to inflate occupied cells of a map
+    * @param map           occupancy grid
+    * @param radius        radius of robot in meters
+    */
+   void compute(const nav_msgs::OccupancyGrid& map, double radius);
+   /**
+    * Function to release cells around a point, e.g. the space taken by the robot itself
+    * @param p             point in map frame
+    * @param radius        radius in meters
+    */
+   void clear(const geometry_msgs::Point& p, double radius);
+
+   // GETTERS
+   /**
+    * Function to get mask of inflated cells, non zero if cell is too close to an obstacle
+    * @return
+    */
+   const std::vector<unsigned char>& getMask(void) const          { return _mask; }
+
+private:
+   std::vector<unsigned short>   _column;             //!< distance to closest obstacle in column in cells, clipped
+   std::vector<unsigned char>    _mask;               //!< inflated cells
+   std::vector<int>              _v;                  //!< apexes of parabolas in lower envelope
+   std::vector<double>           _z;                  //!< borders between parabolas in lower envelope
+
+   unsigned int                  _width;
+   unsigned int                  _height;
+   float                         _resolution;
+   double                        _origin_x;
+   double                        _origin_y;
+};
+
+} /* namespace frontier */
+
+} /* namespace autonohm */
+
+#endif /* OHM_FRONTIER_EXPLORATION_SRC_INFLATION_H_ */
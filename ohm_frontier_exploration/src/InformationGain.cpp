@@ -0,0 +1,318 @@
+/*
+ * InformationGain.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "InformationGain.h"
+
+#include "FrontierFinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+const int DIRTY_BLOCK = 16;            //!< edge length of a block for change detection in cells
+}
+
+namespace autonohm {
+namespace frontier {
+
+InformationGain::InformationGain(InformationGainConfig config) :
+      _config(config)
+    , _width(0)
+    , _height(0)
+    , _resolution(0.0f)
+    , _origin_x(0.0)
+    , _origin_y(0.0)
+    , _range(0)
+    , _dirty_width(0)
+    , _all_dirty(true)
+    , _num_cached(0)
+    , _num_evaluated(0)
+{
+
+}
+
+InformationGain::~InformationGain(void)
+{
+   // nothing to do
+}
+
+void InformationGain::setConfig(InformationGainConfig config)
+{
+   _config = config;
+   _cache.clear();
+   this->buildRayTable();
+}
+
+void InformationGain::setMap(const nav_msgs::OccupancyGrid::ConstPtr& map)
+{
+   const int w = map->info.width;
+   const int h = map->info.height;
+
+   if(map->data.size() != static_cast<unsigned int>(w * h))
+      return;
+
+   const bool sameGeometry = _map && (w == _width) && (h == _height)
+                          && (map->info.resolution        == _resolution)
+                          && (map->info.origin.position.x == _origin_x)
+                          && (map->info.origin.position.y == _origin_y);
+
+   if(!sameGeometry)
+   {
+      _width      = w;
+      _height     = h;
+      _resolution = map->info.resolution;
+      _origin_x   = map->info.origin.position.x;
+      _origin_y   = map->info.origin.position.y;
+
+      _dirty_width = (w + DIRTY_BLOCK - 1) / DIRTY_BLOCK;
+      _dirty.assign(_dirty_width * ((h + DIRTY_BLOCK - 1) / DIRTY_BLOCK), 0);
+      _all_dirty   = true;
+      _cache.clear();
+
+      this->buildRayTable();
+   }
+   else if(!_all_dirty)
+   {
+      // mark blocks with changed cells, marks add up until next evaluation
+      for(int y=0 ; y<h ; y++)
+      {
+         const signed char* newRow = &map->data[y * w];
+         const signed char* oldRow = &_map->data[y * w];
+         unsigned char*     dirty  = &_dirty[(y / DIRTY_BLOCK) * _dirty_width];
+
+         for(int bx=0 ; bx<_dirty_width ; bx++)
+         {
+            if(dirty[bx]) continue;
+
+            const int x   = bx * DIRTY_BLOCK;
+            const int len = std::min(DIRTY_BLOCK, w - x);
+            if(std::memcmp(newRow + x, oldRow + x, len))
+               dirty[bx] = 1;
+         }
+      }
+   }
+
+   _map = map;
+}
+
+
+void InformationGain::evaluate(std::vector<WeightedFrontier>& wf)
+{
+   _num_cached    = 0;
+   _num_evaluated = 0;
+
+   if(!_map || _ray_begin.size() < 2)
+      return;
+
+   for(std::map<unsigned int, CacheEntry>::iterator it=_cache.begin() ; it!=_cache.end() ; ++it)
+      it->second.used = false;
+
+   const unsigned int invalid = std::numeric_limits<unsigned int>::max();
+   std::vector<unsigned int> cells(wf.size(), invalid);
+   std::vector<int>          todo;
+
+   for(unsigned int i=0 ; i<wf.size() ; i++)
+   {
+      if(!wf[i].cached)
+         wf[i].gain = 0.0f;
+
+      const int x = std::floor((wf[i].frontier.position.x - _origin_x) / _resolution);
+      const int y = std::floor((wf[i].frontier.position.y - _origin_y) / _resolution);
+      if(x < 0 || y < 0 || x >= _width || y >= _height)
+         continue;
+
+      cells[i] = y * _width + x;
+
+      std::map<unsigned int, CacheEntry>::iterator it = _cache.find(cells[i]);
+      if(wf[i].cached)
+      {
+         // gain taken over from unchanged frontier, keep its cache entry
+         if(it != _cache.end()) it->second.used = true;
+         _num_cached++;
+      }
+      else if(it != _cache.end() && !this->isDirty(it->second.x0, it->second.y0, it->second.x1, it->second.y1))
+      {
+         it->second.used = true;
+         wf[i].gain      = it->second.gain;
+         _num_cached++;
+      }
+      else
+      {
+         todo.push_back(i);
+      }
+   }
+
+   // raycasting is independent for every frontier
+   std::vector<CacheEntry> results(todo.size());
+   const int windowSize = (2 * _range + 1) * (2 * _range + 1);
+
+#pragma omp parallel
+   {
+      std::vector<unsigned int> visited(windowSize, 0);
+      unsigned int stamp = 0;
+
+#pragma omp for schedule(dynamic)
+      for(int t=0 ; t<static_cast<int>(todo.size()) ; t++)
+      {
+         const unsigned int cell = cells[todo[t]];
+         this->castRays(cell % _width, cell / _width, visited, ++stamp, results[t]);
+      }
+   }
+
+   for(unsigned int t=0 ; t<todo.size() ; t++)
+   {
+      results[t].used        = true;
+      _cache[cells[todo[t]]] = results[t];
+      wf[todo[t]].gain       = results[t].gain;
+   }
+   _num_evaluated = todo.size();
+
+   // drop gains of frontiers which disappeared
+   for(std::map<unsigned int, CacheEntry>::iterator it=_cache.begin() ; it!=_cache.end() ; )
+   {
+      if(!it->second.used) _cache.erase(it++);
+      else                 ++it;
+   }
+
+   // cache is valid for current map now
+   _all_dirty = false;
+   std::fill(_dirty.begin(), _dirty.end(), 0);
+}
+
+
+void InformationGain::buildRayTable(void)
+{
+   _ray_begin.clear();
+   _ray_dx.clear();
+   _ray_dy.clear();
+   _ray_offset.clear();
+   _ray_window.clear();
+
+   if(_resolution <= 0.0f || _config.sensor_range <= 0.0 || _config.angular_resolution <= 0.0)
+      return;
+
+   _range = std::max(1, static_cast<int>(_config.sensor_range / _resolution));
+   const int numRays    = std::max(4, static_cast<int>(std::ceil(2.0 * M_PI / _config.angular_resolution)));
+   const int windowEdge = 2 * _range + 1;
+   const int range2     = _range * _range;
+
+   for(int r=0 ; r<numRays ; r++)
+   {
+      _ray_begin.push_back(_ray_dx.size());
+
+      const double angle = 2.0 * M_PI * r / numRays;
+      const int    ex    = static_cast<int>(std::floor(_range * std::cos(angle) + 0.5));
+      const int    ey    = static_cast<int>(std::floor(_range * std::sin(angle) + 0.5));
+
+      // bresenham from origin to end of ray, origin itself is not part of the ray
+      const int adx = std::abs(ex);
+      const int ady = std::abs(ey);
+      const int sx  = ex < 0 ? -1 : 1;
+      const int sy  = ey < 0 ? -1 : 1;
+      int err = adx - ady;
+      int x   = 0;
+      int y   = 0;
+
+      while(x != ex || y != ey)
+      {
+         const int e2 = 2 * err;
+         if(e2 > -ady) { err -= ady; x += sx; }
+         if(e2 <  adx) { err += adx; y += sy; }
+
+         if(x * x + y * y > range2)
+            break;
+
+         _ray_dx.push_back(x);
+         _ray_dy.push_back(y);
+         _ray_offset.push_back(y * _width + x);
+         _ray_window.push_back((y + _range) * windowEdge + (x + _range));
+      }
+   }
+   _ray_begin.push_back(_ray_dx.size());
+}
+
+
+void InformationGain::castRays(int x, int y, std::vector<unsigned int>& visited, unsigned int stamp, CacheEntry& entry) const
+{
+   const signed char* map    = &_map->data[0];
+   const int          origin = y * _width + x;
+   const bool         inside = (x - _range >= 0)     && (y - _range >= 0) &&
+                               (x + _range < _width) && (y + _range < _height);
+   const int          numRays = _ray_begin.size() - 1;
+
+   unsigned int gain = 0;
+   int minX = 0, minY = 0, maxX = 0, maxY = 0;
+
+   for(int r=0 ; r<numRays ; r++)
+   {
+      const int end = _ray_begin[r + 1];
+      int last      = -1;
+
+      for(int k=_ray_begin[r] ; k<end ; k++)
+      {
+         // bounds only need to be checked close to the border of the map
+         if(!inside)
+         {
+            const int cx = x + _ray_dx[k];
+            const int cy = y + _ray_dy[k];
+            if(cx < 0 || cy < 0 || cx >= _width || cy >= _height)
+               break;
+         }
+
+         last = k;
+         const signed char cell = map[origin + _ray_offset[k]];
+
+         if(cell > FREE)
+            break;                           // ray ends at obstacle
+
+         if(cell == UNKNOWN && visited[_ray_window[k]] != stamp)
+         {
+            visited[_ray_window[k]] = stamp;
+            gain++;
+         }
+      }
+
+      // rays are straight, last cell spans the covered area together with origin
+      if(last >= 0)
+      {
+         minX = std::min(minX, _ray_dx[last]);
+         maxX = std::max(maxX, _ray_dx[last]);
+         minY = std::min(minY, _ray_dy[last]);
+         maxY = std::max(maxY, _ray_dy[last]);
+      }
+   }
+
+   entry.gain = gain;
+   entry.x0   = x + minX;
+   entry.y0   = y + minY;
+   entry.x1   = x + maxX;
+   entry.y1   = y + maxY;
+}
+
+
+bool InformationGain::isDirty(int x0, int y0, int x1, int y1) const
+{
+   if(_all_dirty)
+      return true;
+
+   const int bx0 = std::max(0, x0) / DIRTY_BLOCK;
+   const int by0 = std::max(0, y0) / DIRTY_BLOCK;
+   const int bx1 = std::min(_width  - 1, x1) / DIRTY_BLOCK;
+   const int by1 = std::min(_height - 1, y1) / DIRTY_BLOCK;
+
+   for(int by=by0 ; by<=by1 ; by++)
+      for(int bx=bx0 ; bx<=bx1 ; bx++)
+         if(_dirty[by * _dirty_width + bx])
+            return true;
+
+   return false;
+}
+
+} /* namespace frontier */
+} /* namespace autonohm */
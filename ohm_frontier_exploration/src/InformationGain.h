@@ -0,0 +1,150 @@
+/*
+ * InformationGain.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef OHM_FRONTIER_EXPLORATION_SRC_INFORMATIONGAIN_H_
+#define OHM_FRONTIER_EXPLORATION_SRC_INFORMATIONGAIN_H_
+
+#include <nav_msgs/OccupancyGrid.h>
+
+#include "Frontier.h"
+
+#include <map>
+#include <vector>
+
+/**
+ * @namespace autonohm
+ */
+namespace autonohm {
+
+namespace frontier {
+
+/**
+ * @struct  InformationGainConfig
+ * @date    2026-10-19
+ *
+ * @brief   Parameters of the simulated range sensor
+ */
+struct InformationGainConfig
+{
+   double sensor_range;                    //!< maximum range of sensor in meters
+   double angular_resolution;              //!< angle between two rays in rad
+};
+
+
+/**
+ * @class   InformationGain
+ * @date    2026-10-19
+ *
+ * @brief   Counts unknown cells visible from each frontier within sensor range.
+ *
+ * Rays are taken from a table of cell offsets that is only rebuilt if range,
+ * resolution or map width change. Gains are cached per frontier cell and only
+ * recalculated if a cell inside the area covered by its rays changed.
+ */
+class InformationGain
+{
+public:
+   /**
+    * Constructor with config initialization
+    * @param config
+    */
+   InformationGain(InformationGainConfig config);
+   /**
+    * Default destructor
+    */
+   virtual ~InformationGain(void);
+
+   // SETTERS
+   /**
+    * Function to set sensor configuration, drops the cache
+    * @param config
+    */
+   void setConfig(InformationGainConfig config);
+   /**
+    * Function to set map. Marks changed regions against the previous map.
+    * @param map
+    */
+   void setMap(const nav_msgs::OccupancyGrid::ConstPtr& map);
+
+   // GETTERS
+   /**
+    * Function to get number of gains taken from cache in last evaluation
+    * @return
+    */
+   unsigned int getNumCached(void) const     { return _num_cached; }
+   /**
+    * Function to get number of raycasted frontiers in last evaluation
+    * @return
+    */
+   unsigned int getNumEvaluated(void) const  { return _num_evaluated; }
+
+   // PROCESSING
+   /**
+    * Function to set gain of all frontiers, cached frontiers keep their gain
+    * @param wf            frontiers in map frame
+    */
+   void evaluate(std::vector<WeightedFrontier>& wf);
+
+private:
+   /**
+    * @struct CacheEntry
+    */
+   struct CacheEntry
+   {
+      unsigned int gain;                   //!< number of visible unknown cells
+      int          x0, y0, x1, y1;         //!< cells touched by rays
+      bool         used;                   //!< entry was requested in current evaluation
+   };
+
+   /**
+    * Function to build ray offset table for current map
+    */
+   void buildRayTable(void);
+   /**
+    * Function to count visible unknown cells around a cell
+    * @param x             column of origin
+    * @param y             row of origin
+    * @param visited       per thread buffer of window size
+    * @param stamp         id of current evaluation in visited buffer
+    * @param entry         resulting gain and bounding box
+    */
+   void castRays(int x, int y, std::vector<unsigned int>& visited, unsigned int stamp, CacheEntry& entry) const;
+   /**
+    * Function to check if any cell in rectangle changed since last map
+    */
+   bool isDirty(int x0, int y0, int x1, int y1) const;
+
+
+   InformationGainConfig            _config;
+
+   nav_msgs::OccupancyGrid::ConstPtr _map;               //!< current map, shared and never modified
+   int                              _width;
+   int                              _height;
+   float                            _resolution;
+   double                           _origin_x;
+   double                           _origin_y;
+
+   int                              _range;              //!< sensor range in cells
+   std::vector<int>                 _ray_begin;          //!< first entry of ray i in offset table, size is rays + 1
+   std::vector<int>                 _ray_dx;             //!< column offset of ray cell
+   std::vector<int>                 _ray_dy;             //!< row offset of ray cell
+   std::vector<int>                 _ray_offset;         //!< index offset of ray cell in map
+   std::vector<int>                 _ray_window;         //!< index of ray cell in visited window
+
+   std::vector<unsigned char>       _dirty;              //!< changed blocks since last map
+   int                              _dirty_width;
+   bool                             _all_dirty;
+
+   std::map<unsigned int, CacheEntry> _cache;            //!< gains by cell index of frontier
+   unsigned int                     _num_cached;
+   unsigned int                     _num_evaluated;
+};
+
+} /* namespace frontier */
+
+} /* namespace autonohm */
+
+#endif /* OHM_FRONTIER_EXPLORATION_SRC_INFORMATIONGAIN_H_ */
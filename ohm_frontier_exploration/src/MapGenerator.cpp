@@ -0,0 +1,307 @@
+/*
+ * MapGenerator.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "MapGenerator.h"
+
+#include <algorithm>
+
+namespace {
+const signed char FREE_CELL     = 0;
+const signed char OCCUPIED_CELL = 100;
+const signed char UNKNOWN_CELL  = -1;
+
+const unsigned char KNOWN  = 1;          //!< cell was seen by exploration
+const unsigned char QUEUED = 2;          //!< cell was added to wavefront
+}
+
+namespace autonohm {
+namespace frontier {
+
+MapGenerator::MapGenerator(MapGeneratorConfig config) :
+      _config(config)
+    , _state(1)
+{
+
+}
+
+MapGenerator::~MapGenerator(void)
+{
+   // nothing to do
+}
+
+bool MapGenerator::getType(const std::string& name, MAP_TYPE& type)
+{
+   if(name == "rooms")     type = MAP_ROOMS;
+   else if(name == "cave") type = MAP_CAVE;
+   else if(name == "maze") type = MAP_MAZE;
+   else                    return false;
+   return true;
+}
+
+std::string MapGenerator::getName(MAP_TYPE type)
+{
+   switch(type)
+   {
+   case MAP_ROOMS: return "rooms";
+   case MAP_CAVE:  return "cave";
+   case MAP_MAZE:  return "maze";
+   }
+   return "unknown";
+}
+
+void MapGenerator::generate(nav_msgs::OccupancyGrid& map)
+{
+   _state = _config.seed ? _config.seed : 1;
+
+   map.info.width                = _config.width;
+   map.info.height               = _config.height;
+   map.info.resolution           = _config.resolution;
+   map.info.origin.position.x    = -0.5 * _config.width  * _config.resolution;
+   map.info.origin.position.y    = -0.5 * _config.height * _config.resolution;
+   map.info.origin.position.z    = 0.0;
+   map.info.origin.orientation.x = 0.0;
+   map.info.origin.orientation.y = 0.0;
+   map.info.origin.orientation.z = 0.0;
+   map.info.origin.orientation.w = 1.0;
+
+   map.data.clear();
+   if(!_config.width || !_config.height)
+      return;
+
+   switch(_config.type)
+   {
+   case MAP_ROOMS: this->generateRooms(map.data); break;
+   case MAP_CAVE:  this->generateCave(map.data);  break;
+   case MAP_MAZE:  this->generateMaze(map.data);  break;
+   }
+
+   this->explore(map.data);
+}
+
+
+unsigned int MapGenerator::random(void)
+{
+   // xorshift, same sequence on every platform
+   _state ^= _state << 13;
+   _state ^= _state >> 17;
+   _state ^= _state << 5;
+   return _state;
+}
+
+
+void MapGenerator::generateRooms(std::vector<signed char>& cells)
+{
+   const unsigned int w    = _config.width;
+   const unsigned int h    = _config.height;
+   const unsigned int r    = std::max(_config.room_size, 4u);
+   const unsigned int door = std::max(r / 5, 2u);
+
+   cells.assign(w * h, FREE_CELL);
+
+   // walls on a grid of rooms, every fourth row of rooms is a corridor without inner walls
+   for(unsigned int y=0 ; y<h ; y++)
+   {
+      const bool corridor = ((y / r) % 4 == 2);
+      for(unsigned int x=0 ; x<w ; x++)
+      {
+         if((y % r == 0) || (!corridor && (x % r == 0)))
+            cells[y * w + x] = OCCUPIED_CELL;
+      }
+   }
+
+   // doors in most walls between two rooms
+   for(unsigned int y0=0 ; y0<h ; y0+=r)
+   {
+      for(unsigned int x0=0 ; x0<w ; x0+=r)
+      {
+         const unsigned int len = std::min(r, w - x0);
+         if(len > door + 2 && (this->random() % 4))
+         {
+            const unsigned int x = x0 + 1 + this->random() % (len - door - 1);
+            for(unsigned int i=0 ; i<door ; i++) cells[y0 * w + x + i] = FREE_CELL;
+         }
+
+         const unsigned int height = std::min(r, h - y0);
+         if(height > door + 2 && (this->random() % 4))
+         {
+            const unsigned int y = y0 + 1 + this->random() % (height - door - 1);
+            for(unsigned int i=0 ; i<door ; i++) cells[(y + i) * w + x0] = FREE_CELL;
+         }
+      }
+   }
+
+   // outer walls
+   for(unsigned int x=0 ; x<w ; x++) cells[x] = cells[(h - 1) * w + x] = OCCUPIED_CELL;
+   for(unsigned int y=0 ; y<h ; y++) cells[y * w] = cells[y * w + w - 1] = OCCUPIED_CELL;
+}
+
+
+void MapGenerator::generateCave(std::vector<signed char>& cells)
+{
+   const unsigned int w = _config.width;
+   const unsigned int h = _config.height;
+
+   // random noise, cells are 1 if occupied
+   std::vector<unsigned char> a(w * h);
+   std::vector<unsigned char> b(w * h);
+   for(unsigned int i=0 ; i<w*h ; i++)
+      a[i] = (this->random() % 100) < 45;
+
+   // smooth noise, cell gets occupied if most cells of 3x3 neighbourhood are occupied
+   std::vector<unsigned char> column(w);
+   for(unsigned int iteration=0 ; iteration<4 ; iteration++)
+   {
+      for(unsigned int y=0 ; y<h ; y++)
+      {
+         if(y == 0 || y == h - 1)
+         {
+            std::fill(b.begin() + y * w, b.begin() + (y + 1) * w, 1);
+            continue;
+         }
+
+         const unsigned char* above = &a[(y - 1) * w];
+         const unsigned char* row   = &a[y * w];
+         const unsigned char* below = &a[(y + 1) * w];
+         for(unsigned int x=0 ; x<w ; x++)
+            column[x] = above[x] + row[x] + below[x];
+
+         unsigned char* out = &b[y * w];
+         out[0] = out[w - 1] = 1;
+         for(unsigned int x=1 ; x+1<w ; x++)
+            out[x] = (column[x - 1] + column[x] + column[x + 1]) >= 5;
+      }
+      a.swap(b);
+   }
+
+   cells.resize(w * h);
+   for(unsigned int i=0 ; i<w*h ; i++)
+      cells[i] = a[i] ? OCCUPIED_CELL : FREE_CELL;
+}
+
+
+void MapGenerator::generateMaze(std::vector<signed char>& cells)
+{
+   const unsigned int w     = _config.width;
+   const unsigned int h     = _config.height;
+   const unsigned int width = std::max(_config.room_size, 1u);    // width of corridors
+   const unsigned int pitch = width + 1;
+   const unsigned int nx    = (w - 1) / pitch;
+   const unsigned int ny    = (h - 1) / pitch;
+
+   cells.assign(w * h, OCCUPIED_CELL);
+   if(!nx || !ny)
+      return;
+
+   // randomized depth first search over maze cells
+   std::vector<unsigned char> visited(nx * ny, 0);
+   std::vector<unsigned int>  stack;
+   stack.push_back(0);
+   visited[0] = 1;
+
+   while(!stack.empty())
+   {
+      const unsigned int c  = stack.back();
+      const unsigned int cx = c % nx;
+      const unsigned int cy = c / nx;
+
+      // carve cell
+      for(unsigned int y=0 ; y<width ; y++)
+         std::fill(cells.begin() + (cy * pitch + 1 + y) * w + cx * pitch + 1,
+                   cells.begin() + (cy * pitch + 1 + y) * w + cx * pitch + 1 + width, FREE_CELL);
+
+      unsigned int next[4];
+      unsigned int n = 0;
+      if(cx > 0      && !visited[c - 1])  next[n++] = c - 1;
+      if(cx + 1 < nx && !visited[c + 1])  next[n++] = c + 1;
+      if(cy > 0      && !visited[c - nx]) next[n++] = c - nx;
+      if(cy + 1 < ny && !visited[c + nx]) next[n++] = c + nx;
+
+      if(!n)
+      {
+         stack.pop_back();
+         continue;
+      }
+
+      // remove wall to random neighbour
+      const unsigned int d  = next[this->random() % n];
+      const unsigned int dx = d % nx;
+      const unsigned int dy = d / nx;
+      if(dy == cy)
+      {
+         const unsigned int x = std::max(cx, dx) * pitch;
+         for(unsigned int y=0 ; y<width ; y++)
+            cells[(cy * pitch + 1 + y) * w + x] = FREE_CELL;
+      }
+      else
+      {
+         const unsigned int y = std::max(cy, dy) * pitch;
+         std::fill(cells.begin() + y * w + cx * pitch + 1,
+                   cells.begin() + y * w + cx * pitch + 1 + width, FREE_CELL);
+      }
+
+      visited[d] = 1;
+      stack.push_back(d);
+   }
+}
+
+
+void MapGenerator::explore(std::vector<signed char>& cells)
+{
+   const int          w    = _config.width;
+   const int          h    = _config.height;
+   const unsigned int size = w * h;
+
+   const double       ratio  = std::min(std::max(_config.unknown_ratio, 0.0), 1.0);
+   const unsigned int target = static_cast<unsigned int>((1.0 - ratio) * size);
+   if(target >= size)
+      return;
+
+   std::vector<unsigned char> state(size, 0);
+   unsigned int known = 0;
+
+   // start at first free cell from center
+   unsigned int start = (h / 2) * w + w / 2;
+   while(start < size && cells[start] != FREE_CELL) start++;
+
+   std::vector<unsigned int> queue;
+   if(start < size)
+   {
+      queue.push_back(start);
+      state[start] = QUEUED;
+   }
+
+   // wavefront over free space, reached cells and their neighbours are known
+   for(unsigned int head=0 ; head<queue.size() && known<target ; head++)
+   {
+      const unsigned int idx = queue[head];
+      const int x = idx % w;
+      const int y = idx / w;
+
+      for(int ny=std::max(y - 1, 0) ; ny<=std::min(y + 1, h - 1) ; ny++)
+      {
+         for(int nx=std::max(x - 1, 0) ; nx<=std::min(x + 1, w - 1) ; nx++)
+         {
+            const unsigned int n = ny * w + nx;
+            if(!(state[n] & KNOWN))
+            {
+               state[n] |= KNOWN;
+               known++;
+            }
+            if((nx == x || ny == y) && !(state[n] & QUEUED) && cells[n] == FREE_CELL)
+            {
+               state[n] |= QUEUED;
+               queue.push_back(n);
+            }
+         }
+      }
+   }
+
+   for(unsigned int i=0 ; i<size ; i++)
+      if(!(state[i] & KNOWN)) cells[i] = UNKNOWN_CELL;
+}
+
+} /* namespace frontier */
+} /* namespace autonohm */
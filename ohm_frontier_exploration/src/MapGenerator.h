@@ -0,0 +1,140 @@
+/*
+ * MapGenerator.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef OHM_FRONTIER_EXPLORATION_SRC_MAPGENERATOR_H_
+#define OHM_FRONTIER_EXPLORATION_SRC_MAPGENERATOR_H_
+
+#include <nav_msgs/OccupancyGrid.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * @namespace autonohm
+ */
+namespace autonohm {
+
+namespace frontier {
+
+/**
+ * @enum MAP_TYPE
+ */
+enum MAP_TYPE {
+   MAP_ROOMS = 0,       //!< rooms connected by doors and corridors
+   MAP_CAVE,            //!< cave like noise smoothed by cellular automaton
+   MAP_MAZE             //!< maze with corridors of constant width
+};
+
+/**
+ * @struct  MapGeneratorConfig
+ * @date    2026-10-19
+ *
+ * @brief   Parameters of synthetic maps
+ */
+struct MapGeneratorConfig
+{
+   MAP_TYPE     type;
+   unsigned int width;                     //!< width in cells
+   unsigned int height;                    //!< height in cells
+   float        resolution;                //!< size of a cell in meters
+   double       unknown_ratio;             //!< part of all cells which stays unknown, 0.0 to 1.0
+   unsigned int room_size;                 //!< size of rooms in cells, width of maze corridors
+   unsigned int seed;                      //!< seed of random numbers, same seed gives same map
+
+   MapGeneratorConfig(void) :
+         type(MAP_ROOMS)
+       , width(1000)
+       , height(1000)
+       , resolution(0.05f)
+       , unknown_ratio(0.5)
+       , room_size(80)
+       , seed(1)
+   { }
+};
+
+
+/**
+ * @class   MapGenerator
+ * @date    2026-10-19
+ *
+ * @brief   Generates synthetic occupancy grids for tests and benchmarks.
+ *
+ * The environment is generated first and then explored by a wavefront from
+ * the free cell next to the map's center, until the requested part of the
+ * map is known. Cells behind the wavefront stay unknown, so the map has
+ * frontiers like a partially explored map.
+ */
+class MapGenerator
+{
+public:
+   /**
+    * Constructor with config initialization
+    * @param config
+    */
+   MapGenerator(MapGeneratorConfig config);
+   /**
+    * Default destructor
+    */
+   virtual ~MapGenerator(void);
+
+   // SETTERS
+   /**
+    * Function to set configuration
+    * @param config
+    */
+   void setConfig(MapGeneratorConfig config)                      { _config = config; }
+
+   // GETTERS
+   /**
+    * Function to get configuration
+    * @return
+    */
+   const MapGeneratorConfig& getConfig(void) const                { return _config; }
+   /**
+    * Function to get map type from its name
+    * @param name          rooms, cave or maze
+    * @param type          resulting type
+    * @return              false if name is unknown
+    */
+   static bool getType(const std::string& name, MAP_TYPE& type);
+   /**
+    * Function to get name of map type
+    * @param type
+    * @return
+    */
+   static std::string getName(MAP_TYPE type);
+
+   // PROCESSING
+   /**
+    * Function to generate a map, origin is set to the map's center
+    * @param map           resulting map, header is not touched
+    */
+   void generate(nav_msgs::OccupancyGrid& map);
+
+private:
+   /**
+    * Function to get next random number
+    */
+   unsigned int random(void);
+
+   void generateRooms(std::vector<signed char>& cells);
+   void generateCave(std::vector<signed char>& cells);
+   void generateMaze(std::vector<signed char>& cells);
+   /**
+    * Function to hide cells which are not reached by exploration from center
+    * @param cells         environment, everything not explored is set to unknown
+    */
+   void explore(std::vector<signed char>& cells);
+
+   MapGeneratorConfig            _config;
+   unsigned int                  _state;              //!< state of random number generator
+};
+
+} /* namespace frontier */
+
+} /* namespace autonohm */
+
+#endif /* OHM_FRONTIER_EXPLORATION_SRC_MAPGENERATOR_H_ */
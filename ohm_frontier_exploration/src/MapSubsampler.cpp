@@ -9,16 +9,16 @@
 
 #include <math.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace autonohm {
 
-double round(double number)
+MapSubsampler::MapSubsampler(void) :
+      _levels(2)
 {
-    return number < 0.0 ? ceil(number - 0.5) : floor(number + 0.5);
-}
-
-MapSubsampler::MapSubsampler(void)
-{
-
+   this->setPriority(CLASS_OCCUPIED, CLASS_UNKNOWN, CLASS_FREE);
 }
 
 
@@ -34,43 +34,182 @@ void MapSubsampler::setInput(nav_msgs::OccupancyGrid map)
 }
 
 
-void MapSubsampler::convert(void)
+void MapSubsampler::setPriority(CELL_CLASS highest, CELL_CLASS middle, CELL_CLASS lowest)
 {
-   const float factor = 2.0f;
+   const CELL_CLASS order[3] = {highest, middle, lowest};
 
-   // copy header info
-   _sub                 = _map;
-   _sub.info.resolution = _map.info.resolution * factor;
-   _sub.info.width      = _map.info.width      / factor;
-   _sub.info.height     = _map.info.height     / factor;
+   for(unsigned int bits=0 ; bits<8 ; bits++)
+   {
+      _value[bits] = -1;
+      for(unsigned int i=0 ; i<3 ; i++)
+      {
+         if(bits & order[i])
+         {
+            _value[bits] = (order[i] == CLASS_FREE) ? 0 : ((order[i] == CLASS_OCCUPIED) ? 100 : -1);
+            break;
+         }
+      }
+   }
+}
 
-//   _sub.info.origin.position.x   = _map.info.origin.position.x / factor;
-//   _sub.info.origin.position.y   = _map.info.origin.position.y / factor;
 
-   _sub.data.resize(_sub.info.width*_sub.info.height);
+nav_msgs::OccupancyGrid MapSubsampler::getLevel(unsigned int level) const
+{
+   nav_msgs::OccupancyGrid grid;
+   if(level >= _classes.size())
+      return grid;
+
+   grid.header          = _header;
+   grid.info            = _info;
+   grid.info.resolution = _info.resolution * (1 << level);
+   grid.info.width      = _width[level];
+   grid.info.height     = _height[level];
+
+   const std::vector<unsigned char>& classes = _classes[level];
+   grid.data.resize(classes.size());
+   for(unsigned int i=0 ; i<classes.size() ; i++)
+      grid.data[i] = _value[classes[i]];
+
+   return grid;
+}
 
-   // check for unknown space
-   for(   unsigned int h=0 ; h<_sub.info.height ;  h++) {
-      for(unsigned int w=0 ; w<_map.info.width  ;  w++)
+
+void MapSubsampler::getFrontierCandidates(unsigned int level, std::vector<unsigned int>& candidates) const
+{
+   candidates.clear();
+   if(level >= _classes.size())
+      return;
+
+   const std::vector<unsigned char>& c = _classes[level];
+   const unsigned int w = _width[level];
+   const unsigned int h = _height[level];
+
+   for(unsigned int y=0 ; y<h ; y++)
+   {
+      for(unsigned int x=0 ; x<w ; x++)
       {
-         const unsigned int sub_idx = h*_map.info.height + w;
+         const unsigned int idx = y * w + x;
+         if(!(c[idx] & CLASS_FREE))
+            continue;
+
+         // unknown neighbour of a free cell is either in same block or in a 4-neighbour
+         unsigned char n = c[idx];
+         if(x > 0)     n |= c[idx - 1];
+         if(x + 1 < w) n |= c[idx + 1];
+         if(y > 0)     n |= c[idx - w];
+         if(y + 1 < h) n |= c[idx + w];
+
+         if(n & CLASS_UNKNOWN)
+            candidates.push_back(idx);
+      }
+   }
+}
 
-         const unsigned int col = sub_idx % _sub.info.height;
-         const unsigned int row = std::floor(sub_idx / _sub.info.height);
 
-         const unsigned int map_idx = row*factor*_map.info.height + col*factor;
+void MapSubsampler::convert(void)
+{
+   this->convert(_map);
+}
 
-         int values[3] = {-1, 0, 100};
 
-         for(unsigned int i=0 ; i<3 ; i++)
-         {
-            for(unsigned int f=0 ; f<factor ; f++)
-            {
-               if(_map.data[map_idx+f]                  == values[i])   _sub.data[sub_idx] = values[i];
-               if(_map.data[map_idx+_map.info.height+f] == values[i])   _sub.data[sub_idx] = values[i];
-            }
-         }
+void MapSubsampler::convert(const nav_msgs::OccupancyGrid& map)
+{
+   _classes.clear();
+   _width.clear();
+   _height.clear();
 
+   _header = map.header;
+   _info   = map.info;
+
+   if(map.data.size() != map.info.width * map.info.height || map.data.empty())
+   {
+      ROS_ERROR("MapSubsampler -> map data does not fit to size of %dx%d", map.info.width, map.info.height);
+      return;
+   }
+
+   _width.push_back(map.info.width);
+   _height.push_back(map.info.height);
+   _classes.resize(1);
+   _classes[0].resize(map.data.size());
+   classify(reinterpret_cast<const signed char*>(&map.data[0]), &_classes[0][0], map.data.size());
+
+   // stop if level would not get smaller anymore
+   while(_classes.size() < _levels && (_width.back() > 1 || _height.back() > 1))
+   {
+      const unsigned int w = (_width.back()  + 1) / 2;
+      const unsigned int h = (_height.back() + 1) / 2;
+
+      _classes.push_back(std::vector<unsigned char>(w * h));
+      const std::vector<unsigned char>& src = _classes[_classes.size() - 2];
+
+      reduce(&src[0], _width.back(), _height.back(), &_classes.back()[0], w, h);
+
+      _width.push_back(w);
+      _height.push_back(h);
+   }
+}
+
+
+void MapSubsampler::classify(const signed char* src, unsigned char* dst, unsigned int size)
+{
+   unsigned int i = 0;
+
+#ifdef __SSE2__
+   const __m128i zero         = _mm_setzero_si128();
+   const __m128i freeBits     = _mm_set1_epi8(CLASS_FREE);
+   const __m128i unknownBits  = _mm_set1_epi8(CLASS_UNKNOWN);
+   const __m128i occupiedBits = _mm_set1_epi8(CLASS_OCCUPIED);
+
+   for( ; i + 16 <= size ; i += 16)
+   {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      __m128i c =                _mm_and_si128(_mm_cmpeq_epi8(v, zero), freeBits);
+      c         = _mm_or_si128(c, _mm_and_si128(_mm_cmplt_epi8(v, zero), unknownBits));
+      c         = _mm_or_si128(c, _mm_and_si128(_mm_cmpgt_epi8(v, zero), occupiedBits));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), c);
+   }
+#endif
+
+   for( ; i<size ; i++)
+      dst[i] = (src[i] == 0) ? CLASS_FREE : ((src[i] < 0) ? CLASS_UNKNOWN : CLASS_OCCUPIED);
+}
+
+
+void MapSubsampler::reduce(const unsigned char* src, unsigned int srcWidth, unsigned int srcHeight,
+                           unsigned char*       dst, unsigned int dstWidth, unsigned int dstHeight)
+{
+   for(unsigned int y=0 ; y<dstHeight ; y++)
+   {
+      // odd sizes: last row and column of a block is repeated
+      const unsigned char* row0 = src + 2 * y * srcWidth;
+      const unsigned char* row1 = (2 * y + 1 < srcHeight) ? row0 + srcWidth : row0;
+      unsigned char*       out  = dst + y * dstWidth;
+
+      unsigned int x = 0;
+
+#ifdef __SSE2__
+      const __m128i lowByte = _mm_set1_epi16(0x00ff);
+
+      for( ; 2 * x + 32 <= srcWidth ; x += 16)
+      {
+         __m128i a = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 2 * x)),
+                                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 2 * x)));
+         __m128i b = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 2 * x + 16)),
+                                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 2 * x + 16)));
+
+         // combine neighbouring bytes into the low byte of each 16 bit lane
+         a = _mm_and_si128(_mm_or_si128(a, _mm_srli_epi16(a, 8)), lowByte);
+         b = _mm_and_si128(_mm_or_si128(b, _mm_srli_epi16(b, 8)), lowByte);
+
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_packus_epi16(a, b));
+      }
+#endif
+
+      for( ; x<dstWidth ; x++)
+      {
+         const unsigned int c0 = 2 * x;
+         const unsigned int c1 = (c0 + 1 < srcWidth) ? c0 + 1 : c0;
+         out[x] = row0[c0] | row0[c1] | row1[c0] | row1[c1];
       }
    }
 }
@@ -11,13 +11,37 @@
 #include <ros/ros.h>
 #include <nav_msgs/OccupancyGrid.h>
 
+#include <algorithm>
+#include <vector>
 
-namespace autonohm {
 
+namespace autonohm {
 
+/**
+ * @class   MapSubsampler
+ * @author  Christian Pfitzner
+ * @date    2015-01-27
+ *
+ * @brief   Builds a pyramid of occupancy grids, every level halves the resolution.
+ *
+ * Every cell of a level stores which cell states (free, unknown, occupied)
+ * occur in the 2x2 block below it. The occupancy value of a coarse cell is
+ * the state with highest priority in its block, by default
+ * occupied > unknown > free.
+ */
 class MapSubsampler
 {
 public:
+   /**
+    * @enum CELL_CLASS
+    * Bits of a cell in the pyramid
+    */
+   enum CELL_CLASS {
+      CLASS_FREE     = 1,
+      CLASS_UNKNOWN  = 2,
+      CLASS_OCCUPIED = 4
+   };
+
    /**
     * Default destructor
     */
@@ -29,23 +53,92 @@ public:
 
    // SETTERS
    void setInput(nav_msgs::OccupancyGrid map);
+   /**
+    * Function to set number of levels including full resolution
+    * @param levels
+    */
+   void setLevels(unsigned int levels)                      { _levels = std::max(1u, levels); }
+   /**
+    * Function to set priority of cell states for reduction of a block,
+    * arguments are CELL_CLASS values from highest to lowest priority
+    * @param highest
+    * @param middle
+    * @param lowest
+    */
+   void setPriority(CELL_CLASS highest, CELL_CLASS middle, CELL_CLASS lowest);
 
    // GETTERS
    /**
     * Function to get costmap
     * @return
     */
-   nav_msgs::OccupancyGrid getSubsampledMap(void) const    { return _sub; }
+   nav_msgs::OccupancyGrid getSubsampledMap(void) const     { return this->getLevel(1); }
+   /**
+    * Function to get occupancy grid of a level, 0 is full resolution
+    * @param level
+    * @return
+    */
+   nav_msgs::OccupancyGrid getLevel(unsigned int level) const;
+   /**
+    * Function to get number of levels of last conversion
+    * @return
+    */
+   unsigned int getNumLevels(void) const                    { return _width.size(); }
+   /**
+    * Function to get width of a level in cells
+    */
+   unsigned int getWidth(unsigned int level) const          { return _width[level]; }
+   /**
+    * Function to get height of a level in cells
+    */
+   unsigned int getHeight(unsigned int level) const         { return _height[level]; }
+   /**
+    * Function to get CELL_CLASS bits of all cells of a level
+    * @param level
+    * @return
+    */
+   const std::vector<unsigned char>& getClasses(unsigned int level) const { return _classes[level]; }
+
+   /**
+    * Function to find cells of a level which may contain frontier cells,
+    * which are cells containing free space next to unknown space
+    * @param level         level to search in
+    * @param candidates    indices of cells on level
+    */
+   void getFrontierCandidates(unsigned int level, std::vector<unsigned int>& candidates) const;
 
    // PROCESSING
    /**
     * Function to start conversion
     */
    void convert(void);
+   /**
+    * Function to start conversion of a map without copying it
+    * @param map
+    */
+   void convert(const nav_msgs::OccupancyGrid& map);
 
 private:
+   /**
+    * Function to sort cells into CELL_CLASS bits
+    */
+   static void classify(const signed char* src, unsigned char* dst, unsigned int size);
+   /**
+    * Function to combine bits of 2x2 blocks
+    */
+   static void reduce(const unsigned char* src, unsigned int srcWidth, unsigned int srcHeight,
+                      unsigned char*       dst, unsigned int dstWidth, unsigned int dstHeight);
+
    nav_msgs::OccupancyGrid    _map;          //!< input map for converter
-   nav_msgs::OccupancyGrid    _sub;          //!< output costmap
+   nav_msgs::MapMetaData      _info;         //!< meta data of full resolution map
+   std_msgs::Header           _header;       //!< header of full resolution map
+
+   unsigned int               _levels;       //!< number of levels including full resolution
+   signed char                _value[8];     //!< occupancy value for combination of CELL_CLASS bits
+
+   std::vector<std::vector<unsigned char> > _classes;  //!< CELL_CLASS bits of each level
+   std::vector<unsigned int>  _width;        //!< width of each level
+   std::vector<unsigned int>  _height;       //!< height of each level
 };
 
 } /* namespace autonohm */
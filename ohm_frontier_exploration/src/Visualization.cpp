@@ -7,17 +7,62 @@
 
 #include "Visualization.h"
 
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/**
+ * Function to check if marker of a frontier has to be updated
+ */
+bool differs(const autonohm::WeightedFrontier& a, const autonohm::WeightedFrontier& b)
+{
+   return (a.frontier.position.x != b.frontier.position.x)
+       || (a.frontier.position.y != b.frontier.position.y)
+       || (a.weight              != b.weight);
+}
+
+bool samePose(const geometry_msgs::Pose& a, const geometry_msgs::Pose& b)
+{
+   return (a.position.x    == b.position.x)    && (a.position.y    == b.position.y)
+       && (a.orientation.z == b.orientation.z) && (a.orientation.w == b.orientation.w);
+}
+
+const signed char   CELL_FRONTIER     = 100;
+const signed char   CELL_FREE         = 0;
+const unsigned int  KEYFRAME_INTERVAL = 20;   //!< updates of frontier cells from one keyframe to the next
+
+bool sameGeometry(const nav_msgs::MapMetaData& a, const nav_msgs::MapMetaData& b)
+{
+   return (a.width             == b.width)
+       && (a.height            == b.height)
+       && (a.resolution        == b.resolution)
+       && (a.origin.position.x == b.origin.position.x)
+       && (a.origin.position.y == b.origin.position.y);
+}
+}
 
 namespace autonohm {
 
 namespace frontier {
 
-Visualization::Visualization(void)
+Visualization::Visualization(void) :
+      _rate(0.0)
+    , _flush_pending(false)
+    , _resend_markers(false)
+    , _best_shown(false)
+    , _cells_shown(false)
+    , _update_valid(false)
+    , _update_seq(0)
+    , _since_keyframe(0)
 {
    ros::NodeHandle privat_nh("~");
-   _idx = 0;
 
-   _frontier_maker_pub = _nh.advertise<visualization_msgs::MarkerArray>("frontier_marker_array", 100);
+   _frontier_maker_pub  = _nh.advertise<visualization_msgs::MarkerArray>("frontier_marker_array", 100,
+         ros::SubscriberStatusCallback(boost::bind(&Visualization::markerConnectCallback, this, _1)));
+   _frontier_grid_pub   = _nh.advertise<nav_msgs::GridCells>("frontier_grid", 1,
+         ros::SubscriberStatusCallback(boost::bind(&Visualization::gridConnectCallback, this, _1)));
+   _frontier_update_pub = _nh.advertise<ohm_autonomy_msgs::GridUpdate>("frontier_grid_update", 10,
+         ros::SubscriberStatusCallback(boost::bind(&Visualization::gridUpdateConnectCallback, this, _1)));
 }
 
 Visualization::~Visualization(void)
@@ -25,115 +70,332 @@ Visualization::~Visualization(void)
 
 }
 
+void Visualization::setFrontierCells(const std::vector<unsigned int>& cells, const nav_msgs::MapMetaData& info)
+{
+   boost::mutex::scoped_lock lock(_mutex);
+   _cells = cells;
+   _info  = info;
+
+   // deltas of cells are found by merging sorted lists
+   std::sort(_cells.begin(), _cells.end());
+}
+
+void Visualization::setRate(double rate)
+{
+   // timer is never stopped while holding _mutex, stop() waits for a running flushCallback
+   _flush_timer.stop();
+   {
+      boost::mutex::scoped_lock lock(_mutex);
+      _rate = rate;
+   }
+   if(rate > 0.0)
+      _flush_timer = _nh.createTimer(ros::Duration(1.0 / rate), &Visualization::flushCallback, this);
+}
+
 void Visualization::publish(void)
 {
+   boost::mutex::scoped_lock lock(_mutex);
+   const ros::Time now = ros::Time::now();
+   if(_rate > 0.0 && (now - _last_publish).toSec() < 1.0 / _rate)
+   {
+      // last state is sent by the flush timer even if no further update follows
+      _flush_pending = true;
+      return;
+   }
+
+   this->publishNow();
+}
+
+
+// PRIVATE
+void Visualization::publishNow(void)
+{
+   const ros::Time now = ros::Time::now();
+   _flush_pending = false;
+
+   this->publishMarkers(now);
+   this->publishFrontierCells(now);
+   this->publishFrontierUpdate(now);
+
+   _last_publish = now;
+}
+
+
+void Visualization::flushCallback(const ros::TimerEvent& event)
+{
+   boost::mutex::scoped_lock lock(_mutex);
+   // nothing skipped or already sent by a later publish
+   if(!_flush_pending)
+      return;
+   if(_rate > 0.0 && (ros::Time::now() - _last_publish).toSec() < 1.0 / _rate)
+      return;
+   this->publishNow();
+}
+
+
+void Visualization::markerConnectCallback(const ros::SingleSubscriberPublisher& pub)
+{
+   // subscribers already connected get markers they have again, which rviz ignores
+   boost::mutex::scoped_lock lock(_mutex);
+   _resend_markers = true;
+   _best_shown     = false;
+   this->publishMarkers(ros::Time::now());
+}
+
+
+void Visualization::gridConnectCallback(const ros::SingleSubscriberPublisher& pub)
+{
+   boost::mutex::scoped_lock lock(_mutex);
+   _cells_shown = false;
+   this->publishFrontierCells(ros::Time::now());
+}
+
+
+void Visualization::gridUpdateConnectCallback(const ros::SingleSubscriberPublisher& pub)
+{
+   boost::mutex::scoped_lock lock(_mutex);
+   _update_valid = false;
+   this->publishFrontierUpdate(ros::Time::now());
+}
+
+
+void Visualization::publishMarkers(const ros::Time& stamp)
+{
+   if(!_frontier_maker_pub.getNumSubscribers())
+   {
+      // a new subscriber gets all markers
+      _shown.clear();
+      _best_shown = false;
+      return;
+   }
+
    _markers.markers.clear();
-   _idx = 0;
 
-   if(_frontiers.size() > 0) {
-      this->publishFrontierMarker();
+   // add or modify markers of new and changed frontiers
+   std::map<unsigned int, WeightedFrontier> current;
+   for(std::vector<WeightedFrontier>::const_iterator it=_wFrontiers.begin() ; it != _wFrontiers.end() ; ++it)
+   {
+      current[it->id] = *it;
+
+      std::map<unsigned int, WeightedFrontier>::const_iterator shown = _shown.find(it->id);
+      if(_resend_markers || shown == _shown.end() || differs(*it, shown->second))
+         this->addFrontierMarkers(*it, stamp);
    }
-   if(_wFrontiers.size() > 0) {
-      this->publishWeightedFrontierMarker();
+   _resend_markers = false;
+
+   // delete markers of removed frontiers
+   for(std::map<unsigned int, WeightedFrontier>::const_iterator it=_shown.begin() ; it != _shown.end() ; ++it)
+   {
+      if(!current.count(it->first))
+         this->addDeleteMarkers(it->first, stamp);
    }
+   _shown.swap(current);
 
    if(_bestFrontier.position.x != 0 &&
       _bestFrontier.position.y != 0) {
-      this->publishBestFrontier();
+      this->addBestFrontier(stamp);
    }
 
    if(_markers.markers.size() > 0) {
       _frontier_maker_pub.publish(_markers);
    }
-
 }
 
 
-// PRIVATE
-void Visualization::publishFrontierMarker(void)
+void Visualization::publishFrontierCells(const ros::Time& stamp)
 {
-   unsigned int idx = 0;
+   if(!_frontier_grid_pub.getNumSubscribers())
+   {
+      _cells_shown = false;
+      return;
+   }
+
+   if(_cells_shown && sameGeometry(_info, _shownInfo) && (_cells == _shownCells))
+      return;
+
+   nav_msgs::GridCells layer;
+   layer.header.frame_id = "/map";
+   layer.header.stamp    = stamp;
+   layer.cell_width      = _info.resolution;
+   layer.cell_height     = _info.resolution;
 
-   for(std::vector<Frontier>::const_iterator it=_frontiers.begin() ; it != _frontiers.end() ; ++it)
+   // cells are kept as indices, points are only created for publishing
+   layer.cells.resize(_cells.size());
+   for(unsigned int i=0 ; i<_cells.size() ; i++)
    {
-      visualization_msgs::MarkerArray frontier_markers;
-      visualization_msgs::Marker m;
-      m.header.frame_id = "/map";
-      m.header.stamp    = ros::Time::now();
-      m.ns              = "frontiers";
-      m.id              = idx++;
-
-      m.type            = visualization_msgs::Marker::CYLINDER;
-      m.action          = visualization_msgs::Marker::ADD;
-      m.lifetime        = ros::Duration(5.0f);
-
-      // set color
-      m.color.r         = 0.0f;
-      m.color.g         = 1.0f;
-      m.color.b         = 0.0f;
-      m.color.a         = 0.5f;
-
-      // set size
-      m.scale.x         = 0.1f;
-      m.scale.y         = 0.1f;
-      m.scale.z         = 0.5f;
-
-      m.pose.position   =  it->position;
-      m.pose.position.z += m.scale.z / 2.0f;
-
-      _markers.markers.push_back(m);
+      geometry_msgs::Point& p = layer.cells[i];
+      p.x = _info.origin.position.x + (static_cast<double>(_cells[i] % _info.width) + 0.5) * _info.resolution;
+      p.y = _info.origin.position.y + (static_cast<double>(_cells[i] / _info.width) + 0.5) * _info.resolution;
+      p.z = 0.0;
    }
+   _frontier_grid_pub.publish(layer);
 
+   _shownCells  = _cells;
+   _shownInfo   = _info;
+   _cells_shown = true;
 }
 
 
-void Visualization::publishWeightedFrontierMarker(void)
+void Visualization::publishFrontierUpdate(const ros::Time& stamp)
 {
-   unsigned int idx = 0;
+   if(!_frontier_update_pub.getNumSubscribers())
+   {
+      _update_valid = false;
+      return;
+   }
+   if(!_info.width || !_info.height)
+      return;
+
+   const bool keyframe = !_update_valid || !sameGeometry(_info, _updateInfo) || (_since_keyframe + 1 >= KEYFRAME_INTERVAL);
+
+   _update.header.frame_id = "/map";
+   _update.header.stamp    = stamp;
+   _update.keyframe        = keyframe;
+   _update.info            = _info;
+   _update.shift_x         = 0;
+   _update.shift_y         = 0;
+   _update.run_start.clear();
+   _update.run_length.clear();
+   _update.run_value.clear();
+
+   if(keyframe)
+   {
+      // runs of free cells between frontier cells cover the whole grid
+      unsigned int next = 0;
+      for(std::vector<unsigned int>::const_iterator it=_cells.begin() ; it != _cells.end() ; ++it)
+      {
+         if(*it > next)
+            addRun(_update, next, *it - next, CELL_FREE);
+         addRun(_update, *it, 1, CELL_FRONTIER);
+         next = *it + 1;
+      }
+      const unsigned int size = _info.width * _info.height;
+      if(size > next)
+         addRun(_update, next, size - next, CELL_FREE);
+   }
+   else
+   {
+      // cells in only one of both sorted lists changed
+      std::vector<unsigned int>::const_iterator now  = _cells.begin();
+      std::vector<unsigned int>::const_iterator prev = _updateCells.begin();
+      while(now != _cells.end() || prev != _updateCells.end())
+      {
+         if(prev == _updateCells.end() || (now != _cells.end() && *now < *prev))
+            addRun(_update, *now++, 1, CELL_FRONTIER);
+         else if(now == _cells.end() || *prev < *now)
+            addRun(_update, *prev++, 1, CELL_FREE);
+         else
+         {
+            ++now;
+            ++prev;
+         }
+      }
+      if(_update.run_start.empty())
+         return;
+   }
 
-   for(std::vector<WeightedFrontier>::const_iterator it=_wFrontiers.begin() ; it != _wFrontiers.end() ; ++it)
+   _update.seq = _update_seq++;
+   _frontier_update_pub.publish(_update);
+
+   _since_keyframe = keyframe ? 0 : _since_keyframe + 1;
+   _updateCells    = _cells;
+   _updateInfo     = _info;
+   _update_valid   = true;
+}
+
+
+void Visualization::addRun(ohm_autonomy_msgs::GridUpdate& update, unsigned int start, unsigned int length, signed char value)
+{
+   if(!update.run_start.empty() && update.run_value.back() == value
+      && update.run_start.back() + update.run_length.back() == start)
    {
-      visualization_msgs::Marker m;
-      m.header.frame_id  = "/map";
-      m.header.stamp     = ros::Time::now();
-      m.ns               = "weight_frontiers";
-      m.id               = idx++;
-
-      m.type             = visualization_msgs::Marker::CYLINDER;
-      m.action           = visualization_msgs::Marker::ADD;
-      m.lifetime         = ros::Duration(5.0f);
-
-      // set color
-      m.color.r          = 1.0f;
-      m.color.g          = 0.0f;
-      m.color.b          = 0.0f;
-      m.color.a          = 0.5f;
-
-      // set size
-      m.scale.x          = 0.2f;
-      m.scale.y          = 0.2f;
-      m.scale.z          = it->weight;
-
-      m.pose.position    = it->frontier.position;
-      m.pose.position.z += m.scale.z / 2.0f;
-
-      _markers.markers.push_back(m);
+      update.run_length.back() += length;
+      return;
    }
+   update.run_start.push_back(start);
+   update.run_length.push_back(length);
+   update.run_value.push_back(value);
 }
 
 
-void Visualization::publishBestFrontier(void)
+void Visualization::addFrontierMarkers(const WeightedFrontier& f, const ros::Time& stamp)
 {
-   unsigned int idx = 0;
    visualization_msgs::Marker m;
    m.header.frame_id = "/map";
-   m.header.stamp    = ros::Time::now();
+   m.header.stamp    = stamp;
+   m.ns              = "frontiers";
+   m.id              = f.id;
+
+   m.type            = visualization_msgs::Marker::CYLINDER;
+   m.action          = visualization_msgs::Marker::MODIFY;
+   m.lifetime        = ros::Duration(0.0f);
+
+   // set color
+   m.color.r         = 0.0f;
+   m.color.g         = 1.0f;
+   m.color.b         = 0.0f;
+   m.color.a         = 0.5f;
+
+   // set size
+   m.scale.x         = 0.1f;
+   m.scale.y         = 0.1f;
+   m.scale.z         = 0.5f;
+
+   m.pose.position   =  f.frontier.position;
+   m.pose.position.z += m.scale.z / 2.0f;
+
+   _markers.markers.push_back(m);
+
+   // weight of frontier
+   m.ns              = "weight_frontiers";
+
+   // set color
+   m.color.r         = 1.0f;
+   m.color.g         = 0.0f;
+   m.color.b         = 0.0f;
+   m.color.a         = 0.5f;
+
+   // set size
+   m.scale.x         = 0.2f;
+   m.scale.y         = 0.2f;
+   m.scale.z         = std::fabs(f.weight);   // gain may push weights below zero
+
+   m.pose.position   = f.frontier.position;
+   m.pose.position.z += m.scale.z / 2.0f;
+
+   _markers.markers.push_back(m);
+}
+
+
+void Visualization::addDeleteMarkers(unsigned int id, const ros::Time& stamp)
+{
+   visualization_msgs::Marker m;
+   m.header.frame_id = "/map";
+   m.header.stamp    = stamp;
+   m.id              = id;
+   m.action          = visualization_msgs::Marker::DELETE;
+
+   m.ns              = "frontiers";
+   _markers.markers.push_back(m);
+   m.ns              = "weight_frontiers";
+   _markers.markers.push_back(m);
+}
+
+
+void Visualization::addBestFrontier(const ros::Time& stamp)
+{
+   if(_best_shown && samePose(_bestFrontier, _shownBestFrontier))
+      return;
+
+   visualization_msgs::Marker m;
+   m.header.frame_id = "/map";
+   m.header.stamp    = stamp;
    m.ns              = "best_frontier";
-   m.id              = idx++;
+   m.id              = 0;
 
    m.type            = visualization_msgs::Marker::ARROW;
    m.action          = visualization_msgs::Marker::MODIFY;
-   m.lifetime        = ros::Duration(5.0f);
+   m.lifetime        = ros::Duration(0.0f);
 
    // set color
    m.color.r         = 0.0f;
@@ -150,6 +412,9 @@ void Visualization::publishBestFrontier(void)
    m.pose.orientation = _bestFrontier.orientation;
 
    _markers.markers.push_back(m);
+
+   _shownBestFrontier = _bestFrontier;
+   _best_shown        = true;
 }
 
 } /* namespace frontier */
@@ -9,8 +9,14 @@
 #define OHM_FRONTIER_EXPLORATION_SRC_VISUALIZATION_H_
 
 #include <visualization_msgs/MarkerArray.h>
+#include <nav_msgs/GridCells.h>
+#include <nav_msgs/MapMetaData.h>
+#include <ohm_autonomy_msgs/GridUpdate.h>
 #include "Frontier.h"
 
+#include <boost/thread/mutex.hpp>
+#include <map>
+
 /**
  * @namespace autonohm
  */
@@ -26,6 +32,13 @@ namespace frontier {
  * @date    2015-01-28
  *
  * @brief   Visualization for frontier based exploration
+ *
+ * Markers are keyed by frontier id. Only added, changed and removed
+ * frontiers are sent to rviz, and nothing is sent without subscribers.
+ * A new subscriber gets all markers again. Frontier cells are sent as
+ * GridCells for rviz and as runs of changed cells on frontier_grid_update,
+ * which ohm_neg_obst's neg_map_relay turns back into a grid. Updates
+ * skipped by the rate limit are flushed by a timer.
  */
 class Visualization
 {
@@ -42,20 +55,26 @@ public:
    // SETTERS
    void setNodeHandle(ros::NodeHandle nh)                              { _nh = nh; }
    /**
-    * Function to set frontiers for visualization
-    * @param frontiers
+    * Function to set maximum publishing rate, skipped updates are sent with the next one
+    * @param rate          rate in Hz, zero or negative for no limit
     */
-   void setFrontiers(std::vector<Frontier> frontiers)                  { _frontiers    = frontiers; }
+   void setRate(double rate);
    /**
     * Function to set weighted frontiers
     * @param wFrontiers
     */
-   void setWeightedFrontiers(std::vector<WeightedFrontier> wFrontiers) { _wFrontiers   = wFrontiers; }
+   void setWeightedFrontiers(const std::vector<WeightedFrontier>& wFrontiers) { _wFrontiers = wFrontiers; }
    /**
     * Function to set best frontier for next exploration goal
     * @param best
     */
    void setBestFrontier(Frontier best)                                 { _bestFrontier = best; }
+   /**
+    * Function to set frontier cells of map
+    * @param cells         indices of frontier cells
+    * @param info          geometry of map
+    */
+   void setFrontierCells(const std::vector<unsigned int>& cells, const nav_msgs::MapMetaData& info);
 
    // PROCESS
    /**
@@ -64,20 +83,71 @@ public:
    void publish(void);
 private:
 
-   void publishFrontierMarker(void);
-   void publishWeightedFrontierMarker(void);
-   void publishBestFrontier(void);
+   /**
+    * Function to publish all pending changes, caller holds _mutex
+    */
+   void publishNow(void);
+   void publishMarkers(const ros::Time& stamp);
+   void publishFrontierCells(const ros::Time& stamp);
+   void publishFrontierUpdate(const ros::Time& stamp);
+
+   void flushCallback(const ros::TimerEvent& event);
+   void markerConnectCallback(const ros::SingleSubscriberPublisher& pub);
+   void gridConnectCallback(const ros::SingleSubscriberPublisher& pub);
+   void gridUpdateConnectCallback(const ros::SingleSubscriberPublisher& pub);
+
+   /**
+    * Function to append a run to an update, merges it with the last run if possible
+    */
+   static void addRun(ohm_autonomy_msgs::GridUpdate& update, unsigned int start, unsigned int length, signed char value);
 
-   unsigned int                  _idx;
+   /**
+    * Function to add markers of a frontier
+    * @param f             frontier
+    * @param stamp         time of all markers of this publication
+    */
+   void addFrontierMarkers(const WeightedFrontier& f, const ros::Time& stamp);
+   /**
+    * Function to add markers to delete all markers of a frontier
+    * @param id            id of frontier
+    * @param stamp         time of all markers of this publication
+    */
+   void addDeleteMarkers(unsigned int id, const ros::Time& stamp);
+   void addBestFrontier(const ros::Time& stamp);
 
    ros::NodeHandle               _nh;
 
    ros::Publisher                _frontier_maker_pub;
+   ros::Publisher                _frontier_grid_pub;
+   ros::Publisher                _frontier_update_pub;
+
+   boost::mutex                  _mutex;                    //!< guards state against timer and connect callbacks
+   double                        _rate;                     //!< maximum rate of publication
+   ros::Time                     _last_publish;
+   ros::Timer                    _flush_timer;              //!< publishes updates skipped by the rate limit, runs as long as the object
+   bool                          _flush_pending;
 
-   std::vector<Frontier>         _frontiers;                //!< all frontiers
    std::vector<WeightedFrontier> _wFrontiers;               //!< weighted frontiers
    Frontier                      _bestFrontier;
 
+   std::map<unsigned int, WeightedFrontier> _shown;         //!< frontiers shown in rviz by id
+   bool                          _resend_markers;           //!< a subscriber connected and needs all markers
+   bool                          _best_shown;
+   Frontier                      _shownBestFrontier;
+
+   std::vector<unsigned int>     _cells;                    //!< current frontier cells
+   std::vector<unsigned int>     _shownCells;               //!< frontier cells shown in rviz
+   nav_msgs::MapMetaData         _info;
+   nav_msgs::MapMetaData         _shownInfo;
+   bool                          _cells_shown;
+
+   std::vector<unsigned int>     _updateCells;              //!< frontier cells known to clients of update topic
+   nav_msgs::MapMetaData         _updateInfo;
+   bool                          _update_valid;             //!< false sends a keyframe
+   unsigned int                  _update_seq;
+   unsigned int                  _since_keyframe;
+   ohm_autonomy_msgs::GridUpdate _update;
+
    visualization_msgs::MarkerArray _markers;
 };
 
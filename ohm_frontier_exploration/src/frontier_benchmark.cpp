@@ -0,0 +1,235 @@
+/*
+ * frontier_benchmark.cpp
+ *
+ *  Created on: 19.10.2026
+ *
+ * Runs frontier search on synthetic maps without a ros master and reports
+ * time, heap allocations and frontiers per map size.
+ *
+ * usage: frontier_benchmark [-t rooms,cave,maze] [-u unknown_ratio] [-r repetitions] [-l pyramid_levels] [size ...]
+ */
+#include <ros/ros.h>
+
+#include "MapGenerator.h"
+#include "MapSubsampler.h"
+#include "FrontierFinder.h"
+#include "FrontierController.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+/*
+ * Count allocations of whole program, benchmark is single threaded
+ */
+namespace {
+unsigned long g_allocations = 0;
+unsigned long g_bytes       = 0;
+}
+
+#if __cplusplus < 201103L
+#define BENCHMARK_THROW_BAD_ALLOC throw(std::bad_alloc)
+#define BENCHMARK_NOTHROW         throw()
+#else
+#define BENCHMARK_THROW_BAD_ALLOC
+#define BENCHMARK_NOTHROW         noexcept
+#endif
+
+void* operator new(std::size_t size) BENCHMARK_THROW_BAD_ALLOC
+{
+   g_allocations++;
+   g_bytes += size;
+   void* p = std::malloc(size ? size : 1);
+   if(!p) throw std::bad_alloc();
+   return p;
+}
+
+void* operator new[](std::size_t size) BENCHMARK_THROW_BAD_ALLOC
+{
+   return operator new(size);
+}
+
+void operator delete(void* p) BENCHMARK_NOTHROW
+{
+   std::free(p);
+}
+
+void operator delete[](void* p) BENCHMARK_NOTHROW
+{
+   std::free(p);
+}
+
+
+namespace {
+/**
+ * @struct Measurement
+ */
+struct Measurement
+{
+   double        ms;                      //!< fastest run in milliseconds
+   unsigned long allocations;             //!< allocations of one run
+   unsigned long bytes;                   //!< allocated bytes of one run
+
+   Measurement(void) : ms(-1.0), allocations(0), bytes(0) { }
+
+   void start(void)
+   {
+      _allocations = g_allocations;
+      _bytes       = g_bytes;
+      _start       = ros::WallTime::now();
+   }
+
+   void stop(void)
+   {
+      const double t = (ros::WallTime::now() - _start).toSec() * 1000.0;
+      if(ms < 0.0 || t < ms) ms = t;
+      allocations = g_allocations - _allocations;
+      bytes       = g_bytes       - _bytes;
+   }
+
+private:
+   ros::WallTime _start;
+   unsigned long _allocations;
+   unsigned long _bytes;
+};
+
+
+void printUsage(void)
+{
+   std::printf("usage: frontier_benchmark [-t rooms,cave,maze] [-u unknown_ratio] [-r repetitions] [-l pyramid_levels] [size ...]\n");
+}
+}
+
+
+int main(int argc, char **argv)
+{
+   // no ros master needed, only wall time and console
+   ros::Time::init();
+
+   std::vector<autonohm::frontier::MAP_TYPE> types;
+   std::vector<unsigned int>                 sizes;
+   double                                    unknown     = 0.5;
+   int                                       repetitions = 3;
+   int                                       levels      = 3;
+
+   for(int i=1 ; i<argc ; i++)
+   {
+      const std::string arg(argv[i]);
+      if(arg == "-t" && i + 1 < argc)
+      {
+         std::stringstream ss(argv[++i]);
+         std::string name;
+         while(std::getline(ss, name, ','))
+         {
+            autonohm::frontier::MAP_TYPE type;
+            if(!autonohm::frontier::MapGenerator::getType(name, type))
+            {
+               printUsage();
+               return 1;
+            }
+            types.push_back(type);
+         }
+      }
+      else if(arg == "-u" && i + 1 < argc)  unknown     = std::atof(argv[++i]);
+      else if(arg == "-r" && i + 1 < argc)  repetitions = std::max(std::atoi(argv[++i]), 1);
+      else if(arg == "-l" && i + 1 < argc)  levels      = std::max(std::atoi(argv[++i]), 1);
+      else if(std::atoi(argv[i]) > 0)       sizes.push_back(std::min(std::atoi(argv[i]), 8000));
+      else
+      {
+         printUsage();
+         return 1;
+      }
+   }
+
+   if(types.empty())
+   {
+      types.push_back(autonohm::frontier::MAP_ROOMS);
+      types.push_back(autonohm::frontier::MAP_CAVE);
+      types.push_back(autonohm::frontier::MAP_MAZE);
+   }
+   if(sizes.empty())
+   {
+      sizes.push_back(500);
+      sizes.push_back(1000);
+      sizes.push_back(2000);
+      sizes.push_back(4000);
+      sizes.push_back(8000);
+   }
+
+   autonohm::frontier::FinderConfig finderConfig;
+   finderConfig.robot_radius               = 0.6;
+   finderConfig.min_dist_between_frontiers = 1.0;
+   finderConfig.max_search_radius          = 10.0;
+   finderConfig.pyramid_levels             = levels;
+   finderConfig.standoff_distance          = 0.2;
+
+   geometry_msgs::Pose robot;
+   robot.orientation.w = 1.0;
+
+   std::printf("%-6s %6s %8s %10s %9s | %10s %8s %8s | %10s %8s %8s | %10s %8s\n",
+               "type", "size", "unknown", "cells", "frontiers",
+               "subsample", "allocs", "MB",
+               "finder", "allocs", "MB",
+               "controller", "allocs");
+
+   for(unsigned int t=0 ; t<types.size() ; t++)
+   {
+      for(unsigned int s=0 ; s<sizes.size() ; s++)
+      {
+         autonohm::frontier::MapGeneratorConfig config;
+         config.type          = types[t];
+         config.width         = sizes[s];
+         config.height        = sizes[s];
+         config.resolution    = 0.05f;
+         config.unknown_ratio = unknown;
+         config.room_size     = (types[t] == autonohm::frontier::MAP_MAZE) ? 16 : 80;
+         config.seed          = 1;
+
+         nav_msgs::OccupancyGrid* grid = new nav_msgs::OccupancyGrid;
+         autonohm::frontier::MapGenerator generator(config);
+         generator.generate(*grid);
+         nav_msgs::OccupancyGrid::ConstPtr map(grid);
+
+         unsigned int unknownCells = 0;
+         for(unsigned int i=0 ; i<map->data.size() ; i++)
+            if(map->data[i] < 0) unknownCells++;
+
+         Measurement subsample, finder, controller;
+         autonohm::MapSubsampler           subsampler;
+         autonohm::frontier::Finder        frontierFinder(finderConfig);
+         autonohm::FrontierController      frontierController;
+         subsampler.setLevels(levels);
+         frontierFinder.setMap(map);
+
+         for(int r=0 ; r<repetitions ; r++)
+         {
+            subsample.start();
+            subsampler.convert(*map);
+            subsample.stop();
+
+            finder.start();
+            frontierFinder.calculateFrontiers();
+            finder.stop();
+
+            const std::vector<autonohm::WeightedFrontier> wf = frontierFinder.getWeightedFrontiers();
+            controller.start();
+            frontierController.setWeightedFrontiers(wf);
+            frontierController.findBestFrontier(robot);
+            controller.stop();
+         }
+
+         std::printf("%-6s %6u %7.1f%% %10lu %9lu | %8.2fms %8lu %8.1f | %8.2fms %8lu %8.1f | %8.3fms %8lu\n",
+                     autonohm::frontier::MapGenerator::getName(types[t]).c_str(), sizes[s],
+                     100.0 * unknownCells / map->data.size(),
+                     (unsigned long)frontierFinder.getFrontierCells().size(),
+                     (unsigned long)frontierFinder.getWeightedFrontiers().size(),
+                     subsample.ms,  subsample.allocations, subsample.bytes / 1048576.0,
+                     finder.ms,     finder.allocations,    finder.bytes    / 1048576.0,
+                     controller.ms, controller.allocations);
+         std::fflush(stdout);
+      }
+   }
+
+   return 0;
+}
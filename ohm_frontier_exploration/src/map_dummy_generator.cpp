@@ -7,26 +7,21 @@
 #include <ros/ros.h>
 #include <nav_msgs/OccupancyGrid.h>
 
+#include "MapGenerator.h"
 
-int main(int argc,char **argv)
-{
-   ros::init(argc, argv, "map_dummy");
-   ros::NodeHandle nh;
+#include <algorithm>
 
-   ros::Publisher map_pub = nh.advertise<nav_msgs::OccupancyGrid>("/map", 1);
 
+/**
+ * Function to fill small dummy map used for first tests
+ * @param map_dummy
+ */
+void fillDummy(nav_msgs::OccupancyGrid& map_dummy)
+{
    const unsigned int width  = 10;
    const unsigned int height = 10;
    const float        res    = 1;
 
-   // create occupancy grid for testing
-   nav_msgs::OccupancyGrid map_dummy;
-
-   // set header to message
-   map_dummy.header.seq             = 0;
-   map_dummy.header.stamp           = ros::Time::now();
-   map_dummy.header.frame_id        = "/map";
-
    // fill up informations
    map_dummy.info.height            = width;
    map_dummy.info.width             = height;
@@ -42,7 +37,6 @@ int main(int argc,char **argv)
       {
 
          const unsigned int idx = h*height + w;
-//         std::cout << idx << std::endl;
 
          map_dummy.data[idx]    = -1;
 
@@ -51,7 +45,7 @@ int main(int argc,char **argv)
             map_dummy.data[idx] = 0;
          }
 
-//         // obstacles
+         // obstacles
          if(((w>3/res) && (w<7/res)) && ((h==3/res))) {
             map_dummy.data[idx] = 100;
          }
@@ -59,25 +53,75 @@ int main(int argc,char **argv)
          if(((w>3/res) && (w<7/res)) && ((h==7/res))) {
             map_dummy.data[idx] = 100;
          }
-//         if(((w>3/res) && (w<7/res)) && ((h==7/res))) {
-//            map_dummy.data[idx] = 100;
-//         }
-
-//         if(((h<7/res) && (h>3/res)) && ((w==7/res))) {
-//            map_dummy.data[idx] = 100;
-//         }
-//
+
          if(w<=4/res)
             map_dummy.data[idx] = 0;
-//
-//         if(w==0)
-//            map_dummy.data[idx] = 100;
       }
    }
+}
+
 
-   ros::Rate l(0.2);
+int main(int argc,char **argv)
+{
+   ros::init(argc, argv, "map_dummy");
+   ros::NodeHandle nh;
+   ros::NodeHandle private_nh("~");
+
+   std::string type;
+   int         width;
+   int         height;
+   double      resolution;
+   int         room_size;
+   int         seed;
+   double      rate;
+
+   autonohm::frontier::MapGeneratorConfig config;
+   private_nh.param("type",          type,                 std::string("dummy"));
+   private_nh.param("width",         width,                1000);
+   private_nh.param("height",        height,               1000);
+   private_nh.param("resolution",    resolution,           0.05);
+   private_nh.param("unknown_ratio", config.unknown_ratio, 0.5);
+   private_nh.param("room_size",     room_size,            80);
+   private_nh.param("seed",          seed,                 1);
+   private_nh.param("rate",          rate,                 0.2);
+
+   // maps up to 8000x8000 cells
+   config.width      = std::min(std::max(width,  1), 8000);
+   config.height     = std::min(std::max(height, 1), 8000);
+   config.resolution = resolution;
+   config.room_size  = std::max(room_size, 1);
+   config.seed       = seed;
+
+   ros::Publisher map_pub = nh.advertise<nav_msgs::OccupancyGrid>("/map", 1);
+
+   // create occupancy grid for testing
+   nav_msgs::OccupancyGrid map_dummy;
+
+   // set header to message
+   map_dummy.header.seq             = 0;
+   map_dummy.header.stamp           = ros::Time::now();
+   map_dummy.header.frame_id        = "/map";
+
+   if(type == "dummy")
+   {
+      fillDummy(map_dummy);
+   }
+   else if(autonohm::frontier::MapGenerator::getType(type, config.type))
+   {
+      autonohm::frontier::MapGenerator generator(config);
+      generator.generate(map_dummy);
+      ROS_INFO("map_dummy -> generated %s map with %dx%d cells", type.c_str(), config.width, config.height);
+   }
+   else
+   {
+      ROS_ERROR("map_dummy -> unknown map type %s, use dummy, rooms, cave or maze", type.c_str());
+      return 1;
+   }
+
+   ros::Rate l(rate);
    while(ros::ok())
    {
+      map_dummy.header.stamp = ros::Time::now();
       map_pub.publish(map_dummy);
       ros::spinOnce();
       l.sleep();
@@ -85,4 +129,3 @@ int main(int argc,char **argv)
 
 
 }
-
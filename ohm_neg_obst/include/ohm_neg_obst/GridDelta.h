@@ -0,0 +1,92 @@
+/*
+ * GridDelta.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef OHM_NEG_OBST_INCLUDE_OHM_NEG_OBST_GRIDDELTA_H_
+#define OHM_NEG_OBST_INCLUDE_OHM_NEG_OBST_GRIDDELTA_H_
+
+#include <nav_msgs/OccupancyGrid.h>
+#include <ohm_autonomy_msgs/GridUpdate.h>
+
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @class GridDeltaEncoder
+ *
+ * Builds updates of an occupancy grid from consecutive grids. An update carries the cells which changed since the
+ * previous grid as runs of equal value. If the origin moved by whole cells, cells are compared with the shifted
+ * previous grid, so a scrolling window only sends the cells entering it. Every keyframeInterval updates, and
+ * whenever size, resolution or a fraction of a cell of the origin changes, a keyframe with the whole grid is sent.
+ */
+class GridDeltaEncoder
+{
+public:
+  /**
+   * @param keyframeInterval  updates from one keyframe to the next, 1 sends keyframes only
+   */
+  GridDeltaEncoder(const unsigned int keyframeInterval = 20);
+  virtual ~GridDeltaEncoder(void) { }
+
+  void setKeyframeInterval(const unsigned int keyframeInterval);
+
+  /**
+   * Next update is a keyframe, e.g. for a client which just connected. May be called from any thread.
+   */
+  void forceKeyframe(void) { _keyframeRequested = true; }
+
+  /**
+   * Build update from grid and remember grid for the next one
+   * @param grid        grid to be sent
+   * @param update      changes since previous grid
+   */
+  void encode(const nav_msgs::OccupancyGrid& grid, ohm_autonomy_msgs::GridUpdate* const update);
+
+private:
+  bool shiftOf(const nav_msgs::MapMetaData& info, int* const shiftX, int* const shiftY) const;
+
+  unsigned int          _keyframeInterval;
+  unsigned int          _sinceKeyframe;   ///< updates since last keyframe
+  std::atomic<bool>     _keyframeRequested;
+  uint32_t              _seq;
+  bool                  _valid;           ///< a previous grid exists
+  nav_msgs::MapMetaData _info;
+  std::vector<int8_t>   _data;            ///< previous grid
+};
+
+/**
+ * @class GridDeltaDecoder
+ *
+ * Rebuilds an occupancy grid from updates of a GridDeltaEncoder. After a lost update the grid stays invalid until
+ * the next keyframe.
+ */
+class GridDeltaDecoder
+{
+public:
+  GridDeltaDecoder(void);
+  virtual ~GridDeltaDecoder(void) { }
+
+  /**
+   * Apply update to grid
+   * @param update      update following the last applied one, or a keyframe
+   * @return            true if grid is valid after update
+   */
+  bool apply(const ohm_autonomy_msgs::GridUpdate& update);
+
+  /// Grid of last applied update, only meaningful if valid()
+  const nav_msgs::OccupancyGrid& grid(void) const { return _grid; }
+  bool valid(void) const { return _valid; }
+
+private:
+  void shift(const int shiftX, const int shiftY);
+
+  nav_msgs::OccupancyGrid _grid;
+  std::vector<int8_t>     _shifted;
+  uint32_t                _seq;
+  bool                    _valid;
+};
+
+#endif /* OHM_NEG_OBST_INCLUDE_OHM_NEG_OBST_GRIDDELTA_H_ */
@@ -0,0 +1,304 @@
+/*
+ * CloudBinner.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "CloudBinner.h"
+
+#include <ros/ros.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+/// Cells summed up per task of the reduction
+const unsigned int REDUCE_BLOCK = 4096;
+}
+
+CloudBinner::CloudBinner(void):
+  _threads(1),
+  _heightGate(false),
+  _heightMin(0.0),
+  _heightMax(0.0),
+  _heights(false),
+  _offsetX(-1),
+  _offsetY(-1),
+  _offsetZ(-1)
+{
+}
+
+void CloudBinner::setThreads(const unsigned int threads)
+{
+  _threads = std::max(threads, 1u);
+}
+
+void CloudBinner::setHeightGate(const bool enabled, const double min, const double max)
+{
+  _heightGate = enabled;
+  _heightMin  = min;
+  _heightMax  = max;
+}
+
+bool CloudBinner::bin(const sensor_msgs::PointCloud2& cloud, const tf::Transform& toGrid, const tf::Transform& toBase,
+                      const nav_msgs::MapMetaData& info)
+{
+  _offsetX = -1;
+  _offsetY = -1;
+  _offsetZ = -1;
+  for(auto& field : cloud.fields)
+  {
+    if(field.datatype != sensor_msgs::PointField::FLOAT32)
+      continue;
+    if(field.name == "x") _offsetX = field.offset;
+    if(field.name == "y") _offsetY = field.offset;
+    if(field.name == "z") _offsetZ = field.offset;
+  }
+  const uint16_t endian    = 1;
+  const bool     bigEndian = !*reinterpret_cast<const uint8_t*>(&endian);
+  const unsigned int fieldsEnd = std::max(std::max(_offsetX, _offsetY), _offsetZ) + sizeof(float);
+  if((_offsetX < 0) || (_offsetY < 0) || (_offsetZ < 0) || (cloud.is_bigendian != bigEndian) || (cloud.point_step < fieldsEnd))
+  {
+    ROS_WARN_THROTTLE(1.0, "neg_obst_mapper -> cloud needs float32 fields x, y and z in host byte order");
+    return false;
+  }
+  if(cloud.height && cloud.width &&
+     (cloud.data.size() < (cloud.height - 1) * cloud.row_step + cloud.width * cloud.point_step))
+  {
+    ROS_WARN_THROTTLE(1.0, "neg_obst_mapper -> cloud data is smaller than its size");
+    return false;
+  }
+
+  // cells of grid = a * point + b, from images of unit vectors under the transforms
+  Mapping m;
+  const float       inv    = 1.0f / info.resolution;
+  const tf::Vector3 origin = toGrid * tf::Vector3(0.0, 0.0, 0.0);
+  const tf::Vector3 base   = toBase * tf::Vector3(0.0, 0.0, 0.0);
+  for(unsigned int k = 0; k < 3; k++)
+  {
+    const tf::Vector3 unit(k == 0, k == 1, k == 2);
+    const tf::Vector3 e = toGrid * unit - origin;
+    m.ax[k] = static_cast<float>(e.x() * inv);
+    m.ay[k] = static_cast<float>(e.y() * inv);
+    m.az[k] = static_cast<float>((toBase * unit - base).z());
+    m.gz[k] = static_cast<float>(e.z());
+  }
+  m.bx     = static_cast<float>((origin.x() - info.origin.position.x) * inv);
+  m.by     = static_cast<float>((origin.y() - info.origin.position.y) * inv);
+  m.bz     = static_cast<float>(base.z());
+  m.bgz    = static_cast<float>(origin.z());
+  m.width  = static_cast<float>(info.width);
+  m.height = static_cast<float>(info.height);
+  m.zMin   = _heightGate ? static_cast<float>(_heightMin) : -std::numeric_limits<float>::max();
+  m.zMax   = _heightGate ? static_cast<float>(_heightMax) :  std::numeric_limits<float>::max();
+
+  const unsigned int size   = info.width * info.height;
+  const unsigned int points = cloud.width * cloud.height;
+  const float none = std::numeric_limits<float>::max();
+  if(_threads == 1)
+  {
+    _counts.assign(size, 0);
+    if(_heights)
+    {
+      _zMin.assign(size,  none);
+      _zMax.assign(size, -none);
+    }
+    this->binRange(cloud, m, 0, points, &_counts[0], _heights ? &_zMin[0] : NULL, _heights ? &_zMax[0] : NULL);
+  }
+  else
+  {
+    _planes.resize(_threads);
+    for(auto& plane : _planes)
+      plane.resize(size);
+    _zMinPlanes.resize(_heights ? _threads : 0);
+    _zMaxPlanes.resize(_heights ? _threads : 0);
+    for(unsigned int t = 0; t < _zMinPlanes.size(); t++)
+    {
+      _zMinPlanes[t].resize(size);
+      _zMaxPlanes[t].resize(size);
+    }
+
+#pragma omp parallel num_threads(_threads)
+    {
+      unsigned int thread  = 0;
+      unsigned int threads = 1;
+#ifdef _OPENMP
+      thread  = omp_get_thread_num();
+      threads = omp_get_num_threads();
+#endif
+      // ranges are fixed by number of planes, so fewer threads than requested only take longer
+      for(unsigned int t = thread; t < _threads; t += threads)
+      {
+        std::fill(_planes[t].begin(), _planes[t].end(), 0);
+        float* zMin = NULL;
+        float* zMax = NULL;
+        if(_heights)
+        {
+          std::fill(_zMinPlanes[t].begin(), _zMinPlanes[t].end(),  none);
+          std::fill(_zMaxPlanes[t].begin(), _zMaxPlanes[t].end(), -none);
+          zMin = &_zMinPlanes[t][0];
+          zMax = &_zMaxPlanes[t][0];
+        }
+        this->binRange(cloud, m, static_cast<uint64_t>(points) * t / _threads,
+                       static_cast<uint64_t>(points) * (t + 1) / _threads, &_planes[t][0], zMin, zMax);
+      }
+    }
+    this->reduce(size);
+  }
+
+  _cells.clear();
+  for(unsigned int i = 0; i < size; i++)
+    if(_counts[i])
+      _cells.push_back(i);
+  return true;
+}
+
+void CloudBinner::binRange(const sensor_msgs::PointCloud2& cloud, const Mapping& m, const unsigned int begin,
+                           const unsigned int end, uint16_t* plane, float* zMin, float* zMax) const
+{
+  const unsigned int width = static_cast<unsigned int>(m.width);
+
+  // NaN of invalid points fails every comparison, so they are dropped with points outside of the grid
+  auto mark = [&](const float cx, const float cy, const float cz, const float gz)
+  {
+    if(!((cx >= 0.0f) && (cx < m.width) && (cy >= 0.0f) && (cy < m.height) && (cz >= m.zMin) && (cz <= m.zMax)))
+      return;
+    const unsigned int idx = static_cast<unsigned int>(cy) * width + static_cast<unsigned int>(cx);
+    if(plane[idx] < std::numeric_limits<uint16_t>::max())
+      plane[idx]++;
+    if(zMin)
+    {
+      zMin[idx] = std::min(zMin[idx], gz);
+      zMax[idx] = std::max(zMax[idx], gz);
+    }
+  };
+  auto read = [&](const uint8_t* p, float& x, float& y, float& z)
+  {
+    std::memcpy(&x, p + _offsetX, sizeof(float));
+    std::memcpy(&y, p + _offsetY, sizeof(float));
+    std::memcpy(&z, p + _offsetZ, sizeof(float));
+  };
+
+#ifdef __SSE2__
+  const __m128 ax0 = _mm_set1_ps(m.ax[0]), ax1 = _mm_set1_ps(m.ax[1]), ax2 = _mm_set1_ps(m.ax[2]), bx = _mm_set1_ps(m.bx);
+  const __m128 ay0 = _mm_set1_ps(m.ay[0]), ay1 = _mm_set1_ps(m.ay[1]), ay2 = _mm_set1_ps(m.ay[2]), by = _mm_set1_ps(m.by);
+  const __m128 az0 = _mm_set1_ps(m.az[0]), az1 = _mm_set1_ps(m.az[1]), az2 = _mm_set1_ps(m.az[2]), bz = _mm_set1_ps(m.bz);
+  const __m128 zero = _mm_setzero_ps(), w = _mm_set1_ps(m.width), h = _mm_set1_ps(m.height);
+  const __m128 gz0 = _mm_set1_ps(m.gz[0]), gz1 = _mm_set1_ps(m.gz[1]), gz2 = _mm_set1_ps(m.gz[2]), bgz = _mm_set1_ps(m.bgz);
+  const __m128 gateMin = _mm_set1_ps(m.zMin), gateMax = _mm_set1_ps(m.zMax);
+#endif
+
+  // range of points may start and end within rows
+  for(unsigned int i = begin; i < end; )
+  {
+    const unsigned int row    = i / cloud.width;
+    const unsigned int rowEnd = std::min(end, (row + 1) * cloud.width);
+    const uint8_t*     points = &cloud.data[row * cloud.row_step];
+    unsigned int       col    = i - row * cloud.width;
+    const unsigned int colEnd = rowEnd - row * cloud.width;
+#ifdef __SSE2__
+    for(; col + 4 <= colEnd; col += 4)
+    {
+      float x[4], y[4], z[4];
+      for(unsigned int k = 0; k < 4; k++)
+        read(points + (col + k) * cloud.point_step, x[k], y[k], z[k]);
+      const __m128 px = _mm_loadu_ps(x), py = _mm_loadu_ps(y), pz = _mm_loadu_ps(z);
+      const __m128 cx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax0, px), _mm_mul_ps(ax1, py)), _mm_add_ps(_mm_mul_ps(ax2, pz), bx));
+      const __m128 cy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ay0, px), _mm_mul_ps(ay1, py)), _mm_add_ps(_mm_mul_ps(ay2, pz), by));
+      const __m128 cz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(az0, px), _mm_mul_ps(az1, py)), _mm_add_ps(_mm_mul_ps(az2, pz), bz));
+      const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_and_ps(_mm_cmpge_ps(cx, zero), _mm_cmplt_ps(cx, w)),
+                                                  _mm_and_ps(_mm_cmpge_ps(cy, zero), _mm_cmplt_ps(cy, h))),
+                                       _mm_and_ps(_mm_cmpge_ps(cz, gateMin), _mm_cmple_ps(cz, gateMax)));
+      const int mask = _mm_movemask_ps(inside);
+      if(!mask)
+        continue;
+      float cxs[4], cys[4], czs[4], gzs[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+      _mm_storeu_ps(cxs, cx);
+      _mm_storeu_ps(cys, cy);
+      _mm_storeu_ps(czs, cz);
+      if(zMin)
+        _mm_storeu_ps(gzs, _mm_add_ps(_mm_add_ps(_mm_mul_ps(gz0, px), _mm_mul_ps(gz1, py)), _mm_add_ps(_mm_mul_ps(gz2, pz), bgz)));
+      for(unsigned int k = 0; k < 4; k++)
+        if(mask & (1 << k))
+          mark(cxs[k], cys[k], czs[k], gzs[k]);
+    }
+#endif
+    for(; col < colEnd; col++)
+    {
+      float x, y, z;
+      read(points + col * cloud.point_step, x, y, z);
+      mark(m.ax[0] * x + m.ax[1] * y + m.ax[2] * z + m.bx,
+           m.ay[0] * x + m.ay[1] * y + m.ay[2] * z + m.by,
+           m.az[0] * x + m.az[1] * y + m.az[2] * z + m.bz,
+           m.gz[0] * x + m.gz[1] * y + m.gz[2] * z + m.bgz);
+    }
+    i = rowEnd;
+  }
+}
+
+void CloudBinner::reduce(const unsigned int size)
+{
+  _counts.resize(size);
+  _zMin.resize(_zMinPlanes.empty() ? 0 : size);
+  _zMax.resize(_zMaxPlanes.empty() ? 0 : size);
+  const int blocks = (size + REDUCE_BLOCK - 1) / REDUCE_BLOCK;
+
+#pragma omp parallel for num_threads(_threads)
+  for(int block = 0; block < blocks; block++)
+  {
+    const unsigned int begin = block * REDUCE_BLOCK;
+    const unsigned int end   = std::min(begin + REDUCE_BLOCK, size);
+    uint16_t*          sum   = &_counts[0];
+    std::memcpy(sum + begin, &_planes[0][begin], (end - begin) * sizeof(uint16_t));
+    for(unsigned int t = 1; t < _planes.size(); t++)
+    {
+      const uint16_t* plane = &_planes[t][0];
+      unsigned int    i     = begin;
+#ifdef __SSE2__
+      // saturating add, counts stay at 65535 like in a single plane
+      for(; i + 8 <= end; i += 8)
+      {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sum + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(plane + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sum + i), _mm_adds_epu16(a, b));
+      }
+#endif
+      for(; i < end; i++)
+        sum[i] = static_cast<uint16_t>(std::min<unsigned int>(sum[i] + plane[i], std::numeric_limits<uint16_t>::max()));
+    }
+
+    if(_zMinPlanes.empty())
+      continue;
+    float* zMin = &_zMin[0];
+    float* zMax = &_zMax[0];
+    std::memcpy(zMin + begin, &_zMinPlanes[0][begin], (end - begin) * sizeof(float));
+    std::memcpy(zMax + begin, &_zMaxPlanes[0][begin], (end - begin) * sizeof(float));
+    for(unsigned int t = 1; t < _zMinPlanes.size(); t++)
+    {
+      const float* planeMin = &_zMinPlanes[t][0];
+      const float* planeMax = &_zMaxPlanes[t][0];
+      unsigned int i        = begin;
+#ifdef __SSE2__
+      for(; i + 4 <= end; i += 4)
+      {
+        _mm_storeu_ps(zMin + i, _mm_min_ps(_mm_loadu_ps(zMin + i), _mm_loadu_ps(planeMin + i)));
+        _mm_storeu_ps(zMax + i, _mm_max_ps(_mm_loadu_ps(zMax + i), _mm_loadu_ps(planeMax + i)));
+      }
+#endif
+      for(; i < end; i++)
+      {
+        zMin[i] = std::min(zMin[i], planeMin[i]);
+        zMax[i] = std::max(zMax[i], planeMax[i]);
+      }
+    }
+  }
+}
@@ -0,0 +1,109 @@
+/*
+ * CloudBinner.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef OHM_NEG_OBST_SRC_CLOUDBINNER_H_
+#define OHM_NEG_OBST_SRC_CLOUDBINNER_H_
+
+#include <sensor_msgs/PointCloud2.h>
+#include <nav_msgs/MapMetaData.h>
+#include <tf/tf.h>
+
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @class CloudBinner
+ *
+ * Counts points of a cloud per cell of a grid. Points are read straight from the message buffer at the offsets of
+ * their fields, transform and scaling to cells are folded into one affine map, SSE2 evaluates it for four points at
+ * once. Points outside an optional height band are dropped in the same pass. Optionally the lowest and highest point
+ * per cell are kept as well, in the frame of the grid.
+ *
+ * With more than one thread the cloud is split into equal ranges of points, every thread counts into its own plane
+ * and the planes are summed afterwards. Sums and extrema do not depend on the order of points, so the result is the
+ * same for any number of threads.
+ */
+class CloudBinner
+{
+public:
+  CloudBinner(void);
+  virtual ~CloudBinner(void) { }
+
+  /**
+   * Set number of threads for binning, 1 bins in the calling thread
+   */
+  void setThreads(const unsigned int threads);
+
+  /**
+   * Set height band of points in frame of height transform, points outside are dropped
+   * @param enabled     without gate all heights are accepted
+   */
+  void setHeightGate(const bool enabled, const double min, const double max);
+
+  /**
+   * Keep lowest and highest point per cell
+   * @param enabled     heights are only valid for cells with points
+   */
+  void setHeights(const bool enabled) { _heights = enabled; }
+
+  /**
+   * Count points of cloud per cell
+   * @param cloud       cloud with float32 fields x, y and z in host byte order
+   * @param toGrid      transform from cloud to frame of grid
+   * @param toBase      transform from cloud to frame of height gate
+   * @param info        size, resolution and origin of grid
+   * @return            false if cloud can not be read
+   */
+  bool bin(const sensor_msgs::PointCloud2& cloud, const tf::Transform& toGrid, const tf::Transform& toBase,
+           const nav_msgs::MapMetaData& info);
+
+  /// Points per cell of last cloud, saturated at 65535
+  const std::vector<uint16_t>& counts(void) const { return _counts; }
+  /// Cells with points of last cloud in ascending order
+  const std::vector<unsigned int>& cells(void) const { return _cells; }
+  /// Height of lowest and highest point per cell in frame of grid, if heights are enabled
+  const std::vector<float>& heightMin(void) const { return _zMin; }
+  const std::vector<float>& heightMax(void) const { return _zMax; }
+  unsigned int threads(void) const { return _threads; }
+
+private:
+  /**
+   * Affine map of points to cells and height
+   */
+  struct Mapping
+  {
+    float ax[3], bx;
+    float ay[3], by;
+    float az[3], bz;
+    float gz[3], bgz;    ///< height in frame of grid
+    float width, height;
+    float zMin, zMax;
+  };
+
+  void binRange(const sensor_msgs::PointCloud2& cloud, const Mapping& m, const unsigned int begin,
+                const unsigned int end, uint16_t* plane, float* zMin, float* zMax) const;
+  void reduce(const unsigned int size);
+
+  unsigned int                        _threads;
+  bool                                _heightGate;
+  double                              _heightMin;
+  double                              _heightMax;
+  bool                                _heights;
+
+  int                                 _offsetX;
+  int                                 _offsetY;
+  int                                 _offsetZ;
+
+  std::vector<std::vector<uint16_t> > _planes;    ///< counts of every thread
+  std::vector<uint16_t>               _counts;    ///< counts of all threads
+  std::vector<std::vector<float> >    _zMinPlanes;
+  std::vector<std::vector<float> >    _zMaxPlanes;
+  std::vector<float>                  _zMin;
+  std::vector<float>                  _zMax;
+  std::vector<unsigned int>           _cells;
+};
+
+#endif /* OHM_NEG_OBST_SRC_CLOUDBINNER_H_ */
@@ -0,0 +1,117 @@
+/*
+ * ElevationDetector.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "ElevationDetector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+/// Rounding symmetric to zero, so rays on both sides of an axis are mirror images
+inline int roundSymmetric(const double value)
+{
+  return (value >= 0.0) ? static_cast<int>(value + 0.5) : -static_cast<int>(-value + 0.5);
+}
+
+const signed char OCCUPIED = 100;
+}
+
+ElevationDetector::ElevationDetector(void):
+  _width(0),
+  _height(0),
+  _step(0.1f),
+  _drop(0.1f)
+{
+}
+
+void ElevationDetector::resize(const unsigned int width, const unsigned int height)
+{
+  _width  = width;
+  _height = height;
+  _parent.resize(width * height);
+  _ground.resize(width * height);
+  _edge.resize(width * height);
+  _order.clear();
+  if(!width || !height)
+    return;
+
+  // a cell at chebyshev distance n has its parent at n - 1, so ordering by n puts parents first
+  const int cx = width / 2;
+  const int cy = height / 2;
+  const int rings = std::max(std::max(cx, static_cast<int>(width) - 1 - cx), std::max(cy, static_cast<int>(height) - 1 - cy));
+  std::vector<std::vector<unsigned int> > ring(rings + 1);
+  for(int row = 0; row < static_cast<int>(height); row++)
+  {
+    for(int col = 0; col < static_cast<int>(width); col++)
+    {
+      const int dx = col - cx;
+      const int dy = row - cy;
+      const int n  = std::max(std::abs(dx), std::abs(dy));
+      const unsigned int idx = row * width + col;
+      if(!n)
+      {
+        _parent[idx] = idx;
+        continue;
+      }
+      const double scale = (n - 1) / static_cast<double>(n);
+      _parent[idx] = (cy + roundSymmetric(dy * scale)) * width + cx + roundSymmetric(dx * scale);
+      ring[n].push_back(idx);
+    }
+  }
+  _order.reserve(width * height - 1);
+  for(auto& cells : ring)
+    _order.insert(_order.end(), cells.begin(), cells.end());
+}
+
+void ElevationDetector::setThresholds(const float step, const float drop)
+{
+  _step = step;
+  _drop = drop;
+}
+
+unsigned int ElevationDetector::detect(const ScrollingGrid& grid, nav_msgs::OccupancyGrid* const map)
+{
+  if((grid.width() != _width) || (grid.height() != _height) || (map->data.size() != _width * _height) || _order.empty())
+    return 0;
+
+  // heights of the robot itself are no ground, rays start without ground
+  const unsigned int center = (_height / 2) * _width + _width / 2;
+  _ground[center] = 0.0f;
+  _edge[center]   = -1;
+
+  unsigned int marked = 0;
+  signed char* data   = &map->data[0];
+  for(auto idx : _order)
+  {
+    const unsigned int parent = _parent[idx];
+    float ground = _ground[parent];
+    int   edge   = _edge[parent];
+
+    const unsigned int cell = grid.index(idx % _width, idx / _width);
+    if(grid.hasHeight(cell))
+    {
+      const float zMin = grid.heightMin(cell);
+      const float zMax = grid.heightMax(cell);
+      if((zMax - zMin > _step) || ((edge >= 0) && (zMax - ground > _step)))
+      {
+        data[idx] = OCCUPIED;
+        marked++;
+      }
+      else if((edge >= 0) && (ground - zMin > _drop) && (data[edge] != OCCUPIED))
+      {
+        data[edge] = OCCUPIED;
+        marked++;
+      }
+      ground = zMin;
+      edge   = idx;
+    }
+    _ground[idx] = ground;
+    _edge[idx]   = edge;
+  }
+  return marked;
+}
@@ -0,0 +1,67 @@
+/*
+ * ElevationDetector.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef OHM_NEG_OBST_SRC_ELEVATIONDETECTOR_H_
+#define OHM_NEG_OBST_SRC_ELEVATIONDETECTOR_H_
+
+#include <nav_msgs/OccupancyGrid.h>
+
+#include <vector>
+
+#include "ScrollingGrid.h"
+
+/**
+ * @class ElevationDetector
+ *
+ * Finds steps and drops in the heights of a scrolling grid along rays from the sensor in its center cell. Rays are
+ * precomputed once per window size as a tree: every cell knows the cell one step closer to the sensor on the line
+ * between both, and cells are ordered by distance to the sensor. One pass in this order carries the height of the
+ * last ground cell outward along all rays at once, so the whole window is checked in time linear in its cells.
+ *
+ * A cell whose highest point is more than the step height above the ground before it, or which holds such a step
+ * itself, is a step. Ground more than the drop height below the ground before it, with or without unobserved cells
+ * in between, makes the last ground cell before it a drop edge.
+ */
+class ElevationDetector
+{
+public:
+  ElevationDetector(void);
+  virtual ~ElevationDetector(void) { }
+
+  /**
+   * Build rays for a window, the sensor is in cell (width / 2, height / 2)
+   * @param width       cells along x
+   * @param height      cells along y
+   */
+  void resize(const unsigned int width, const unsigned int height);
+
+  /**
+   * @param step        height of steps up in meters
+   * @param drop        height of drops in meters
+   */
+  void setThresholds(const float step, const float drop);
+
+  /**
+   * Mark steps and drop edges as occupied
+   * @param grid        heights, window must have the size of the rays
+   * @param map         map of same window
+   * @return            number of marked cells
+   */
+  unsigned int detect(const ScrollingGrid& grid, nav_msgs::OccupancyGrid* const map);
+
+private:
+  unsigned int              _width;
+  unsigned int              _height;
+  std::vector<unsigned int> _parent;   ///< cell one step closer to the sensor
+  std::vector<unsigned int> _order;    ///< cells by distance to the sensor, parents first, without sensor cell
+  std::vector<float>        _ground;   ///< height of last ground cell on ray through cell
+  std::vector<int>          _edge;     ///< last ground cell on ray through cell, -1 if none
+
+  float                     _step;
+  float                     _drop;
+};
+
+#endif /* OHM_NEG_OBST_SRC_ELEVATIONDETECTOR_H_ */
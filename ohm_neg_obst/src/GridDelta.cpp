@@ -0,0 +1,185 @@
+/*
+ * GridDelta.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "ohm_neg_obst/GridDelta.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+/// Origins closer than this fraction of a cell to a whole cell shift are treated as shifted by whole cells
+const double SHIFT_TOLERANCE = 1e-3;
+
+const int8_t UNKNOWN = -1;
+}
+
+GridDeltaEncoder::GridDeltaEncoder(const unsigned int keyframeInterval):
+  _keyframeInterval(std::max(keyframeInterval, 1u)),
+  _sinceKeyframe(0),
+  _keyframeRequested(false),
+  _seq(0),
+  _valid(false)
+{
+}
+
+void GridDeltaEncoder::setKeyframeInterval(const unsigned int keyframeInterval)
+{
+  _keyframeInterval = std::max(keyframeInterval, 1u);
+}
+
+void GridDeltaEncoder::encode(const nav_msgs::OccupancyGrid& grid, ohm_autonomy_msgs::GridUpdate* const update)
+{
+  const unsigned int width  = grid.info.width;
+  const unsigned int height = grid.info.height;
+  int shiftX = 0;
+  int shiftY = 0;
+  const bool requested = _keyframeRequested.exchange(false);
+  bool keyframe = requested || !_valid || (++_sinceKeyframe >= _keyframeInterval) ||
+                  !this->shiftOf(grid.info, &shiftX, &shiftY);
+  if(keyframe)
+  {
+    _sinceKeyframe = 0;
+    shiftX = 0;
+    shiftY = 0;
+  }
+
+  update->header   = grid.header;
+  update->seq      = _seq++;
+  update->keyframe = keyframe;
+  update->info     = grid.info;
+  update->shift_x  = shiftX;
+  update->shift_y  = shiftY;
+  update->run_start.clear();
+  update->run_length.clear();
+  update->run_value.clear();
+  if(grid.data.size() < width * height)
+  {
+    _valid = false;
+    return;
+  }
+
+  // previous value of a cell, cells entering the window were unknown
+  const int8_t* data = &grid.data[0];
+  auto previous = [&](const unsigned int col, const unsigned int row)
+  {
+    const int x = static_cast<int>(col) + shiftX;
+    const int y = static_cast<int>(row) + shiftY;
+    if((x < 0) || (y < 0) || (x >= static_cast<int>(width)) || (y >= static_cast<int>(height)))
+      return UNKNOWN;
+    return _data[y * width + x];
+  };
+
+  // a run starts at a changed cell and goes on while cells have its value, changed or not
+  bool   open  = false;
+  int8_t value = 0;
+  for(unsigned int row = 0; row < height; row++)
+  {
+    const int prevRow = static_cast<int>(row) + shiftY;
+    if(!keyframe && !open && !shiftX && (prevRow >= 0) && (prevRow < static_cast<int>(height)) &&
+       !std::memcmp(data + row * width, &_data[prevRow * width], width))
+      continue;
+    for(unsigned int col = 0; col < width; col++)
+    {
+      const unsigned int idx = row * width + col;
+      if(open && (data[idx] == value))
+      {
+        update->run_length.back()++;
+        continue;
+      }
+      open = keyframe || (data[idx] != previous(col, row));
+      if(!open)
+        continue;
+      value = data[idx];
+      update->run_start.push_back(idx);
+      update->run_length.push_back(1);
+      update->run_value.push_back(value);
+    }
+  }
+
+  _data.assign(grid.data.begin(), grid.data.begin() + width * height);
+  _info  = grid.info;
+  _valid = true;
+}
+
+bool GridDeltaEncoder::shiftOf(const nav_msgs::MapMetaData& info, int* const shiftX, int* const shiftY) const
+{
+  if((info.width != _info.width) || (info.height != _info.height) || (info.resolution != _info.resolution) ||
+     (info.origin.orientation.x != _info.origin.orientation.x) || (info.origin.orientation.y != _info.origin.orientation.y) ||
+     (info.origin.orientation.z != _info.origin.orientation.z) || (info.origin.orientation.w != _info.origin.orientation.w))
+    return false;
+  const double dx = (info.origin.position.x - _info.origin.position.x) / info.resolution;
+  const double dy = (info.origin.position.y - _info.origin.position.y) / info.resolution;
+  const double rx = std::floor(dx + 0.5);
+  const double ry = std::floor(dy + 0.5);
+  if((std::fabs(dx - rx) > SHIFT_TOLERANCE) || (std::fabs(dy - ry) > SHIFT_TOLERANCE) ||
+     (std::fabs(rx) > info.width) || (std::fabs(ry) > info.height))
+    return false;
+  *shiftX = static_cast<int>(rx);
+  *shiftY = static_cast<int>(ry);
+  return true;
+}
+
+GridDeltaDecoder::GridDeltaDecoder(void):
+  _seq(0),
+  _valid(false)
+{
+}
+
+bool GridDeltaDecoder::apply(const ohm_autonomy_msgs::GridUpdate& update)
+{
+  const unsigned int size = update.info.width * update.info.height;
+  if(update.keyframe)
+  {
+    _grid.data.assign(size, UNKNOWN);
+    _valid = true;
+  }
+  else if(!_valid || (update.seq != _seq + 1) || (update.info.width != _grid.info.width) ||
+          (update.info.height != _grid.info.height))
+  {
+    // lost update, wait for next keyframe
+    _valid = false;
+  }
+  else
+  {
+    this->shift(update.shift_x, update.shift_y);
+  }
+  _seq = update.seq;
+  if(!_valid)
+    return false;
+
+  _grid.header = update.header;
+  _grid.info   = update.info;
+  const unsigned int runs = update.run_start.size();
+  if((update.run_length.size() != runs) || (update.run_value.size() != runs))
+    return _valid = false;
+  for(unsigned int i = 0; i < runs; i++)
+  {
+    const uint32_t start = update.run_start[i];
+    const uint32_t end   = start + update.run_length[i];
+    if((end < start) || (end > size))
+      return _valid = false;
+    std::fill(_grid.data.begin() + start, _grid.data.begin() + end, update.run_value[i]);
+  }
+  return true;
+}
+
+void GridDeltaDecoder::shift(const int shiftX, const int shiftY)
+{
+  if(!shiftX && !shiftY)
+    return;
+  const int width  = _grid.info.width;
+  const int height = _grid.info.height;
+  _shifted.assign(width * height, UNKNOWN);
+
+  // cell (x, y) was cell (x + shiftX, y + shiftY), only the overlap of both windows is copied
+  const int colBegin = std::max(0, -shiftX);
+  const int colEnd   = std::min(width, width - shiftX);
+  for(int y = std::max(0, -shiftY); (y < height) && (y + shiftY < height) && (colBegin < colEnd); y++)
+    std::memcpy(&_shifted[y * width + colBegin], &_grid.data[(y + shiftY) * width + colBegin + shiftX], colEnd - colBegin);
+  _grid.data.swap(_shifted);
+}
@@ -0,0 +1,362 @@
+/*
+ * NegObstMapper.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "NegObstMapper.h"
+
+#include <ros/ros.h>
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define N_SECTORS 720
+
+NegObstMapper::NegObstMapper(void):
+  _configured(false),
+  _evidenceThresh(0.5),
+  _fusedFilter(false),
+  _heightMin(0.04),
+  _heightMax(0.1),
+  _minPoints(1),
+  _elevationMode(false)
+{
+}
+
+void NegObstMapper::setEvidence(const float hit, const float miss, const float decay, const float max, const double thresh)
+{
+  _grid.setEvidence(hit, miss, decay, max);
+  _evidenceThresh = thresh;
+}
+
+void NegObstMapper::setFusedFilter(const bool enabled, const double heightMin, const double heightMax,
+                                   const unsigned int minPoints)
+{
+  _fusedFilter = enabled;
+  _heightMin   = heightMin;
+  _heightMax   = heightMax;
+  _minPoints   = std::max(minPoints, 1u);
+}
+
+void NegObstMapper::setElevation(const bool enabled, const unsigned int heightAge)
+{
+  _elevationMode = enabled;
+  _binner.setHeights(enabled);
+  _grid.setHeightAge(std::max(heightAge, 1u));
+}
+
+void NegObstMapper::configure(const MapConfig& config)
+{
+  if(!_configured || (config.width != _config.width) || (config.height != _config.height) || (config.res != _config.res))
+    this->resetMap(&_negMap, config.width, config.height, config.res);
+  _detector.setThresholds(config.stepHeight, config.dropHeight);
+  _config     = config;
+  _configured = true;
+}
+
+bool NegObstMapper::update(const sensor_msgs::PointCloud2& cloud, const tf::Transform& transform, const tf::Transform& base,
+                           StageTimes* const times)
+{
+  StageTimes     local;
+  StageTimes&    t     = times ? *times : local;
+  ros::WallTime  start = ros::WallTime::now();
+  ros::WallTime  stage = start;
+  auto lap = [&stage](double& ms)
+  {
+    const ros::WallTime now = ros::WallTime::now();
+    ms    = (now - stage).toSec() * 1000.0;
+    stage = now;
+  };
+  if(!_configured)
+    return false;
+
+  // pose of cloud in odometry frame, evidence of earlier clouds stays registered while the robot moves
+  const tf::Vector3 sensor = transform.getOrigin();
+  _grid.nextFrame();
+  _grid.scrollTo(sensor.x(), sensor.y());
+  _negMap.header.stamp           = cloud.header.stamp;
+  _negMap.info.origin.position.x = _grid.originX();
+  _negMap.info.origin.position.y = _grid.originY();
+
+  // ground observed in this cloud
+  if(!this->binCloud(cloud, transform, base, sensor))
+    return false;
+  lap(t.bin);
+
+  if(_config.growing)
+    this->growCells(&_negMap, _config.nGrow);
+  lap(t.grow);
+
+  // map shows ground with enough evidence over all clouds instead of this cloud only
+  this->fuseEvidence(_negMap, sensor);
+  lap(t.fuse);
+  this->renderEvidence(&_negMap);
+  lap(t.render);
+
+  this->freeFootprint(&_negMap, 20, 20, 0, 0);
+  lap(t.footprint);
+  if(_elevationMode)
+    _detector.detect(_grid, &_negMap);
+  else
+    this->markWalls(&_negMap, _config.emptyRadius, _config.threshEmpty);
+  lap(t.walls);
+  t.total = (stage - start).toSec() * 1000.0;
+  return true;
+}
+
+void NegObstMapper::renderEvidence(nav_msgs::OccupancyGrid* const map) const
+{
+  for(unsigned int row = 0; row < map->info.height; row++)
+    for(unsigned int col = 0; col < map->info.width; col++)
+      map->data[row * map->info.width + col] = (_grid.evidence(_grid.index(col, row)) >= _evidenceThresh) ? 0 : -1;
+}
+
+void NegObstMapper::resetMap(nav_msgs::OccupancyGrid* const map, const double width, const double height, const double res)
+{
+  map->info.resolution = res;
+  map->info.height = std::floor(height / map->info.resolution);
+  map->info.width  = std::floor(width  / map->info.resolution);
+  map->info.origin.position.x = -width  / 2.0;
+  map->info.origin.position.y = -height / 2.0;
+  _grid.resize(map->info.width, map->info.height, res);
+  _detector.resize(map->info.width, map->info.height);
+}
+
+/*
+ * Sets all cells within nGrow cells (square) of an observed cell to observed. Observed cells closer than nGrow to
+ * the border are no seeds, as their square would not fit into the map. The square is separated into a running
+ * window along rows followed by one along columns, so every cell is touched twice regardless of nGrow.
+ */
+void NegObstMapper::growCells(nav_msgs::OccupancyGrid* const map, const unsigned int nGrow)
+{
+  const unsigned int width  = map->info.width;
+  const unsigned int height = map->info.height;
+  if((2 * nGrow >= width) || (2 * nGrow >= height))
+    return;
+
+  // seeds of a row are padded by zeros, so the running window needs no bounds checks
+  _growSeeds.assign(width + 2 * nGrow + 1, 0);
+  _growRows.assign(width * height, 0);
+  for(unsigned int row = nGrow; row < height - nGrow; row++)
+  {
+    const signed char* data  = &map->data[row * width];
+    unsigned char*     seeds = &_growSeeds[nGrow + 1];
+    unsigned char*     grown = &_growRows[row * width];
+    for(unsigned int col = nGrow; col < width - nGrow; col++)
+      seeds[col] = (data[col] >= 0);
+
+    // seeds in [col - nGrow, col + nGrow]
+    unsigned int count = 0;
+    for(unsigned int col = 0; col < width; col++)
+    {
+      count += _growSeeds[col + 2 * nGrow + 1];
+      count -= _growSeeds[col];
+      grown[col] = (count != 0);
+    }
+  }
+
+  _growCount.assign(width, 0);
+  for(unsigned int row = 0; row < height; row++)
+  {
+    const unsigned char* enter = (row + nGrow < height) ? &_growRows[(row + nGrow) * width] : NULL;
+    const unsigned char* leave = (row > nGrow) ? &_growRows[(row - nGrow - 1) * width] : NULL;
+    signed char*         data  = &map->data[row * width];
+    unsigned int*        count = &_growCount[0];
+    if(enter)
+      for(unsigned int col = 0; col < width; col++)
+        count[col] += enter[col];
+    if(leave)
+      for(unsigned int col = 0; col < width; col++)
+        count[col] -= leave[col];
+    for(unsigned int col = 0; col < width; col++)
+      if(count[col])
+        data[col] = 0;
+  }
+}
+
+/*
+ * Cells observed as ground in this frame gain evidence. Cells without ground between the sensor and the farthest
+ * ground point in their direction lose evidence, as the ground there should have been seen. All other cells are not
+ * touched and decay.
+ */
+void NegObstMapper::fuseEvidence(const nav_msgs::OccupancyGrid& frame, const tf::Vector3& sensor)
+{
+  const double maxRange = std::sqrt(*std::max_element(_sectorRange.begin(), _sectorRange.end()));
+  const double res      = frame.info.resolution;
+  const double originX  = frame.info.origin.position.x;
+  const double originY  = frame.info.origin.position.y;
+  const int colMin = std::max(static_cast<int>(std::floor((sensor.x() - maxRange - originX) / res)), 0);
+  const int rowMin = std::max(static_cast<int>(std::floor((sensor.y() - maxRange - originY) / res)), 0);
+  const int colMax = std::min(static_cast<int>(std::floor((sensor.x() + maxRange - originX) / res)), static_cast<int>(frame.info.width) - 1);
+  const int rowMax = std::min(static_cast<int>(std::floor((sensor.y() + maxRange - originY) / res)), static_cast<int>(frame.info.height) - 1);
+
+  for(int row = rowMin; row <= rowMax; row++)
+  {
+    const double dy = originY + (row + 0.5) * res - sensor.y();
+    for(int col = colMin; col <= colMax; col++)
+    {
+      const unsigned int idx = _grid.index(col, row);
+      if(frame.data[row * frame.info.width + col] >= 0)
+      {
+        _grid.hit(idx);
+        continue;
+      }
+      const double dx = originX + (col + 0.5) * res - sensor.x();
+      if(dx * dx + dy * dy < _sectorRange[sectorOf(dx, dy)])
+        _grid.miss(idx);
+    }
+  }
+}
+
+/*
+ * Sector of a direction, sectors are equal steps of the diamond angle, which is monotonic in the angle and needs no
+ * trigonometric function
+ */
+unsigned int NegObstMapper::sectorOf(const double x, const double y)
+{
+  const double ax = std::fabs(x);
+  const double ay = std::fabs(y);
+  if((ax + ay) <= 0.0)
+    return 0;
+  double angle = ay / (ax + ay);                 // [0, 1] in first quadrant
+  if(x < 0.0) angle = 2.0 - angle;
+  if(y < 0.0) angle = 4.0 - angle;
+  const unsigned int sector = static_cast<unsigned int>(angle * (N_SECTORS / 4));
+  return std::min(sector, static_cast<unsigned int>(N_SECTORS - 1));
+}
+
+/*
+ * Marks cells of the window hit by points of the cloud and the farthest ground point per sector. Points are counted
+ * per cell by the binner, which may split the cloud over several threads.
+ *
+ * With the fused filter, points outside the height band in the robot's frame are dropped while binning, and
+ * cells with fewer than min_points points in their 3x3 neighbourhood are rejected as outliers. This replaces the
+ * chain of voxel, pass through and outlier filter nodes.
+ *
+ * In elevation mode all heights pass, and the lowest and highest point of accepted cells extend the heights of the
+ * grid for step and drop detection.
+ */
+bool NegObstMapper::binCloud(const sensor_msgs::PointCloud2& cloud, const tf::Transform& transform,
+                             const tf::Transform& base, const tf::Vector3& sensor)
+{
+  // elevation needs all heights, so the gate is open in elevation mode
+  _binner.setHeightGate(_fusedFilter && !_elevationMode, _heightMin, _heightMax);
+  if(!_binner.bin(cloud, transform, base, _negMap.info))
+    return false;
+
+  const unsigned int width  = _negMap.info.width;
+  const unsigned int height = _negMap.info.height;
+  _negMap.data.assign(width * height, -1);
+  _sectorRange.assign(N_SECTORS, 0.0);
+  signed char*    data  = &_negMap.data[0];
+  const uint16_t* count = &_binner.counts()[0];
+
+  const double inv  = 1.0 / _negMap.info.resolution;
+  const double sx   = (sensor.x() - _negMap.info.origin.position.x) * inv;
+  const double sy   = (sensor.y() - _negMap.info.origin.position.y) * inv;
+  const double res2 = _negMap.info.resolution * _negMap.info.resolution;
+
+  // only cells with points are visited
+  const unsigned int minPoints = _fusedFilter ? _minPoints : 1;
+  for(auto idx : _binner.cells())
+  {
+    const unsigned int col = idx % width;
+    const unsigned int row = idx / width;
+    unsigned int support = count[idx];
+    for(unsigned int subRow = (row ? row - 1 : 0); (subRow <= row + 1) && (subRow < height) && (support < minPoints); subRow++)
+      for(unsigned int subCol = (col ? col - 1 : 0); (subCol <= col + 1) && (subCol < width); subCol++)
+        if((subRow != row) || (subCol != col))
+          support += count[subRow * width + subCol];
+    if(support < minPoints)
+      continue;
+    data[idx] = 0;
+    if(_elevationMode)
+      _grid.updateHeight(_grid.index(col, row), _binner.heightMin()[idx], _binner.heightMax()[idx]);
+
+    // farthest ground per direction, ground closer to the sensor should have been seen as well
+    const double dx = col + 0.5 - sx;
+    const double dy = row + 0.5 - sy;
+    double& range = _sectorRange[sectorOf(dx, dy)];
+    range = std::max(range, (dx * dx + dy * dy) * res2);
+  }
+  return true;
+}
+
+/*
+ * Marks free cells with more than threshEmpty unknown cells in the square of the given radius around them as wall.
+ * Cells closer than radius to the border are not marked. Unknown cells are summed by a running window along rows
+ * followed by one along columns, so the cost per cell does not depend on the radius. Walls marked here are not
+ * unknown, so all counts can be taken from the map before marking.
+ */
+void NegObstMapper::markWalls(nav_msgs::OccupancyGrid* const map, const unsigned int radius, const unsigned int threshEmpty)
+{
+  const unsigned int width  = map->info.width;
+  const unsigned int height = map->info.height;
+  if((2 * radius >= width) || (2 * radius >= height))
+    return;
+
+  _wallRows.assign(width * height, 0);
+  for(unsigned int row = 0; row < height; row++)
+  {
+    const signed char* data  = &map->data[row * width];
+    uint16_t*          sums  = &_wallRows[row * width];
+    uint16_t           count = 0;
+    for(unsigned int col = 0; col <= 2 * radius; col++)
+      count += (data[col] == -1);
+    sums[radius] = count;
+    for(unsigned int col = radius + 1; col < width - radius; col++)
+    {
+      count += (data[col + radius] == -1);
+      count -= (data[col - radius - 1] == -1);
+      sums[col] = count;
+    }
+  }
+
+  _wallCount.assign(width, 0);
+  uint16_t* count = &_wallCount[0];
+  for(unsigned int row = 0; row <= 2 * radius; row++)
+    for(unsigned int col = 0; col < width; col++)
+      count[col] += _wallRows[row * width + col];
+
+  for(unsigned int row = radius; row < height - radius; row++)
+  {
+    if(row > radius)
+    {
+      const uint16_t* enter = &_wallRows[(row + radius) * width];
+      const uint16_t* leave = &_wallRows[(row - radius - 1) * width];
+      unsigned int col = 0;
+#ifdef __SSE2__
+      for(; col + 8 <= width; col += 8)
+      {
+        __m128i sum = _mm_loadu_si128(reinterpret_cast<const __m128i*>(count + col));
+        sum = _mm_add_epi16(sum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(enter + col)));
+        sum = _mm_sub_epi16(sum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(leave + col)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(count + col), sum);
+      }
+#endif
+      for(; col < width; col++)
+        count[col] += enter[col] - leave[col];
+    }
+
+    signed char* data = &map->data[row * width];
+    for(unsigned int col = radius; col < width - radius; col++)
+      if((data[col] == 0) && (count[col] > threshEmpty))
+        data[col] = 100;
+  }
+}
+
+bool NegObstMapper::freeFootprint(nav_msgs::OccupancyGrid* const map, const unsigned int width, const unsigned int height,
+                                  const unsigned int offsetX, const unsigned int offsetY)
+{
+  for(unsigned int row = map->info.height / 2 - width / 2; row < map->info.height / 2 + width / 2; row++)
+    for(unsigned int col = map->info.width / 2 - height / 2; col < map->info.width / 2 + height / 2; col++)
+    {
+      map->data[row * map->info.width + col] = 0;
+    }
+  return true;
+}
@@ -0,0 +1,153 @@
+/*
+ * NegObstMapper.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef OHM_NEG_OBST_SRC_NEGOBSTMAPPER_H_
+#define OHM_NEG_OBST_SRC_NEGOBSTMAPPER_H_
+
+#include <sensor_msgs/PointCloud2.h>
+#include <nav_msgs/OccupancyGrid.h>
+#include <tf/tf.h>
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "ScrollingGrid.h"
+#include "CloudBinner.h"
+#include "ElevationDetector.h"
+
+/**
+ * Settings changed by dynamic reconfigure. A configuration is never modified after it was published, reconfigure
+ * publishes a new one and the cloud callback picks it up when it starts on the next cloud.
+ */
+struct MapConfig
+{
+  double       width;
+  double       height;
+  double       res;
+  bool         growing;
+  unsigned int nGrow;
+  unsigned int threshEmpty;
+  unsigned int emptyRadius;
+  float        stepHeight;
+  float        dropHeight;
+};
+
+/**
+ * @class NegObstMapper
+ *
+ * Grid logic of neg_obst_mapper without ros communication: bins clouds into a window around the robot, fuses ground
+ * evidence over clouds and marks negative obstacles, either as walls of free cells next to unknown cells or as steps
+ * and drops of the elevation. Not thread safe, all calls have to come from one thread at a time.
+ */
+class NegObstMapper
+{
+public:
+  /**
+   * Duration of stages of one update in milliseconds
+   */
+  struct StageTimes
+  {
+    double bin;
+    double grow;
+    double fuse;
+    double render;
+    double footprint;
+    double walls;
+    double total;
+  };
+
+  NegObstMapper(void);
+  virtual ~NegObstMapper(void) { }
+
+  /**
+   * Set frame of map, clouds are binned in this frame
+   */
+  void setFrame(const std::string& frame) { _negMap.header.frame_id = frame; }
+
+  /**
+   * Set evidence model, see ScrollingGrid::setEvidence
+   * @param thresh      evidence of a cell to be shown as ground
+   */
+  void setEvidence(const float hit, const float miss, const float decay, const float max, const double thresh);
+
+  /**
+   * Set height gate and outlier rejection, which replace a chain of filter nodes
+   * @param enabled     without fused filter all points are accepted
+   * @param heightMin   lowest point in frame of height transform
+   * @param heightMax   highest point in frame of height transform
+   * @param minPoints   points in a cell and its 8 neighbours to be no outlier
+   */
+  void setFusedFilter(const bool enabled, const double heightMin, const double heightMax, const unsigned int minPoints);
+  bool fusedFilter(void) const { return _fusedFilter; }
+
+  void setBinningThreads(const unsigned int threads) { _binner.setThreads(threads); }
+
+  /**
+   * Set detection of steps and drops from heights instead of cells without points
+   * @param heightAge   frames heights of a cell are collected
+   */
+  void setElevation(const bool enabled, const unsigned int heightAge);
+
+  /**
+   * Apply configuration, map and buffers are only resized if the geometry changed
+   */
+  void configure(const MapConfig& config);
+
+  /**
+   * Process one cloud, map() shows the result
+   * @param cloud       cloud with float32 fields x, y and z
+   * @param transform   transform from cloud to frame of map
+   * @param base        transform from cloud to robot's frame, heights are gated there
+   * @param times       duration of stages, may be NULL
+   * @return            false if cloud can not be read
+   */
+  bool update(const sensor_msgs::PointCloud2& cloud, const tf::Transform& transform, const tf::Transform& base,
+              StageTimes* const times = NULL);
+
+  const nav_msgs::OccupancyGrid& map(void) const { return _negMap; }
+
+  /*
+   * Stages of update
+   */
+  bool binCloud(const sensor_msgs::PointCloud2& cloud, const tf::Transform& transform, const tf::Transform& base,
+                const tf::Vector3& sensor);
+  void growCells(nav_msgs::OccupancyGrid* const map, const unsigned int nGrow);
+  void fuseEvidence(const nav_msgs::OccupancyGrid& frame, const tf::Vector3& sensor);
+  void renderEvidence(nav_msgs::OccupancyGrid* const map) const;
+  bool freeFootprint(nav_msgs::OccupancyGrid* const map, const unsigned int width, const unsigned int height,
+                     const unsigned int offsetX, const unsigned int offsetY);
+  void markWalls(nav_msgs::OccupancyGrid* const map, const unsigned int radius, const unsigned int threshEmpty);
+
+private:
+  void resetMap(nav_msgs::OccupancyGrid* const map, const double width, const double height, const double res);
+  static unsigned int sectorOf(const double x, const double y);
+
+  nav_msgs::OccupancyGrid    _negMap;
+  MapConfig                  _config;
+  bool                       _configured;
+  double                     _evidenceThresh;
+
+  ScrollingGrid              _grid;
+  std::vector<double>        _sectorRange;   ///< squared distance of farthest ground point per direction
+
+  bool                       _fusedFilter;   ///< height gate and outlier rejection in the mapper instead of a filter chain
+  double                     _heightMin;
+  double                     _heightMax;
+  unsigned int               _minPoints;     ///< points in a cell and its 8 neighbours to be no outlier
+  CloudBinner                _binner;        ///< points per cell of the current cloud
+
+  bool                       _elevationMode; ///< steps and drops from heights instead of cells without points
+  ElevationDetector          _detector;
+
+  std::vector<unsigned char> _growSeeds;     ///< observed cells of one row, padded for running window
+  std::vector<unsigned char> _growRows;      ///< observed cells grown along rows
+  std::vector<unsigned int>  _growCount;     ///< grown cells per column in window of rows
+  std::vector<uint16_t>      _wallRows;      ///< unknown cells along rows in window of columns
+  std::vector<uint16_t>      _wallCount;     ///< unknown cells per column in window of rows and columns
+};
+
+#endif /* OHM_NEG_OBST_SRC_NEGOBSTMAPPER_H_ */
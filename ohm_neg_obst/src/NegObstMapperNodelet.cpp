@@ -0,0 +1,153 @@
+/*
+ * NegObstMapperNodelet.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "NegObstMapperNodelet.h"
+
+#include <pluginlib/class_list_macros.h>
+#include <nav_msgs/OccupancyGrid.h>
+
+#include <algorithm>
+
+NegObstMapperNodelet::NegObstMapperNodelet(void)
+{
+}
+
+void NegObstMapperNodelet::onInit(void)
+{
+  std::string topicCloudIn;
+  std::string topicMap;
+  std::string topicMapUpdate;
+
+  // callbacks of one subscription never run concurrently, clouds run in parallel to reconfigure and publishing
+  ros::NodeHandle& nh    = this->getMTNodeHandle();
+  ros::NodeHandle& prvNh = this->getMTPrivateNodeHandle();
+  prvNh.param<std::string>("topic_cloud_in", topicCloudIn, "outlier_filter/output");
+  prvNh.param<std::string>("topic_map", topicMap, "neg_map");
+  prvNh.param<std::string>("topic_map_update", topicMapUpdate, "neg_map_update");
+  prvNh.param<std::string>("tf_frame_map", _tfFrameMap, "base_link");
+  prvNh.param<std::string>("tf_frame_odom", _tfFrameOdom, "odom");
+  _mapper.setFrame(_tfFrameOdom);
+
+  double evidenceHit, evidenceMiss, evidenceDecay, evidenceMax, evidenceThresh;
+  prvNh.param<double>("evidence_hit",    evidenceHit,    1.0);
+  prvNh.param<double>("evidence_miss",   evidenceMiss,   0.5);
+  prvNh.param<double>("evidence_decay",  evidenceDecay,  0.9);
+  prvNh.param<double>("evidence_max",    evidenceMax,    5.0);
+  prvNh.param<double>("evidence_thresh", evidenceThresh, 0.5);
+  _mapper.setEvidence(evidenceHit, evidenceMiss, evidenceDecay, evidenceMax, evidenceThresh);
+
+  bool fusedFilter;
+  double heightMin, heightMax;
+  int minPoints;
+  prvNh.param<bool>("fused_filter", fusedFilter, false);
+  prvNh.param<double>("height_min", heightMin, 0.04);
+  prvNh.param<double>("height_max", heightMax, 0.1);
+  prvNh.param<int>("min_points", minPoints, 1);
+  _mapper.setFusedFilter(fusedFilter, heightMin, heightMax, std::max(minPoints, 1));
+
+  int binningThreads;
+  prvNh.param<int>("binning_threads", binningThreads, 1);
+  _mapper.setBinningThreads(std::max(binningThreads, 1));
+
+  bool elevationMode;
+  double stepHeight, dropHeight;
+  int heightAge;
+  prvNh.param<bool>("elevation_mode", elevationMode, false);
+  prvNh.param<double>("step_height", stepHeight, 0.1);
+  prvNh.param<double>("drop_height", dropHeight, 0.1);
+  prvNh.param<int>("height_age", heightAge, 10);
+  _mapper.setElevation(elevationMode, std::max(heightAge, 1));
+
+  int emptyRadius;
+  prvNh.param<int>("empty_radius", emptyRadius, 1);
+
+  std::shared_ptr<MapConfig> config(new MapConfig);
+  config->width       = DEFAULT_WIDTH;
+  config->height      = DEFAULT_HEIGHT;
+  config->res         = DEFAULT_RES;
+  config->growing     = true;
+  config->nGrow       = DEFAULT_N_GROW;
+  config->threshEmpty = DEFAULT_THRESH_EMPTY;
+  config->emptyRadius = std::max(emptyRadius, 1);
+  config->stepHeight  = stepHeight;
+  config->dropHeight  = dropHeight;
+  std::atomic_store(&_config, std::shared_ptr<const MapConfig>(config));
+
+  int keyframeInterval;
+  prvNh.param<int>("keyframe_interval", keyframeInterval, 20);
+  _encoder.setKeyframeInterval(std::max(keyframeInterval, 1));
+
+  _server.reset(new dynamic_reconfigure::Server<ohm_neg_obst::ReconfigureHeightMapperConfig>(prvNh));
+  _server->setCallback(boost::bind(&NegObstMapperNodelet::callbackDynamicReconfigure, this, _1, _2));
+
+  _listener.reset(new tf::TransformListener);
+  _pubMap = nh.advertise<nav_msgs::OccupancyGrid>(topicMap, 1);
+  // clients connecting in between deltas need a keyframe to start from
+  _pubMapUpdate = nh.advertise<ohm_autonomy_msgs::GridUpdate>(topicMapUpdate, 10,
+                  ros::SubscriberStatusCallback(boost::bind(&NegObstMapperNodelet::callbackMapUpdateConnect, this, _1)));
+  _subsCloud = nh.subscribe(topicCloudIn, 1, &NegObstMapperNodelet::callBackCloud, this);
+}
+
+void NegObstMapperNodelet::callBackCloud(const sensor_msgs::PointCloud2::ConstPtr& cloud)
+{
+  // configuration is taken once per cloud, a reconfigure in between takes effect with the next cloud
+  const std::shared_ptr<const MapConfig> config = std::atomic_load(&_config);
+  if(config != _active)
+  {
+    _mapper.configure(*config);
+    _active = config;
+  }
+
+  // pose of cloud in odometry frame, evidence of earlier clouds stays registered while the robot moves
+  tf::StampedTransform transform;
+  tf::StampedTransform base;
+  base.setIdentity();
+  try
+  {
+    _listener->waitForTransform(_tfFrameOdom, cloud->header.frame_id, cloud->header.stamp, ros::Duration(0.1));
+    _listener->lookupTransform(_tfFrameOdom, cloud->header.frame_id, cloud->header.stamp, transform);
+    // height of points is gated in the robot's frame
+    if(_mapper.fusedFilter())
+      _listener->lookupTransform(_tfFrameMap, cloud->header.frame_id, cloud->header.stamp, base);
+  }
+  catch(tf::TransformException& ex)
+  {
+    NODELET_WARN_THROTTLE(1.0, "neg_obst_mapper -> no transform from %s to %s: %s", cloud->header.frame_id.c_str(),
+                          _tfFrameOdom.c_str(), ex.what());
+    return;
+  }
+
+  if(!_mapper.update(*cloud, transform, base))
+    return;
+
+  // full map only for clients which can not read updates, e.g. rviz
+  _encoder.encode(_mapper.map(), &_mapUpdate);
+  _pubMapUpdate.publish(_mapUpdate);
+  if(_pubMap.getNumSubscribers())
+    _pubMap.publish(_mapper.map());
+}
+
+void NegObstMapperNodelet::callbackDynamicReconfigure(ohm_neg_obst::ReconfigureHeightMapperConfig& config, uint32_t level)
+{
+  std::shared_ptr<MapConfig> next(new MapConfig(*std::atomic_load(&_config)));
+  next->height      = config.map_height;
+  next->width       = config.map_width;
+  next->res         = config.map_res;
+  next->growing     = config.growing;
+  next->nGrow       = config.n_grow;
+  next->threshEmpty = config.thresh_empty;
+  next->emptyRadius = config.empty_radius;
+  next->stepHeight  = config.step_height;
+  next->dropHeight  = config.drop_height;
+  std::atomic_store(&_config, std::shared_ptr<const MapConfig>(next));
+}
+
+void NegObstMapperNodelet::callbackMapUpdateConnect(const ros::SingleSubscriberPublisher& pub)
+{
+  _encoder.forceKeyframe();
+}
+
+PLUGINLIB_EXPORT_CLASS(NegObstMapperNodelet, nodelet::Nodelet)
@@ -0,0 +1,69 @@
+/*
+ * NegObstMapperNodelet.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef OHM_NEG_OBST_SRC_NEGOBSTMAPPERNODELET_H_
+#define OHM_NEG_OBST_SRC_NEGOBSTMAPPERNODELET_H_
+
+#include <nodelet/nodelet.h>
+#include <ros/ros.h>
+#include <sensor_msgs/PointCloud2.h>
+#include <dynamic_reconfigure/server.h>
+#include "ohm_neg_obst/ReconfigureHeightMapperConfig.h"
+
+#include <tf/transform_listener.h>
+
+#include <memory>
+#include <string>
+
+#include "NegObstMapper.h"
+#include "ohm_neg_obst/GridDelta.h"
+
+/**
+ * @class NegObstMapperNodelet
+ *
+ * ros interface of NegObstMapper. Loaded into the nodelet manager of the filter chain, clouds of the filters arrive
+ * as shared pointers without serialization. The standalone node neg_obst_mapper loads it into a manager of its own.
+ */
+class NegObstMapperNodelet : public nodelet::Nodelet
+{
+public:
+  NegObstMapperNodelet(void);
+  virtual ~NegObstMapperNodelet(void) { }
+
+private:
+  virtual void onInit(void);
+
+  void callBackCloud(const sensor_msgs::PointCloud2::ConstPtr& cloud);
+  void callbackDynamicReconfigure(ohm_neg_obst::ReconfigureHeightMapperConfig& config, uint32_t level);
+  void callbackMapUpdateConnect(const ros::SingleSubscriberPublisher& pub);
+
+  /*
+   * Map geometry until dynamic reconfigure sets its own
+   */
+  static constexpr double       DEFAULT_WIDTH        = 20.0;
+  static constexpr double       DEFAULT_HEIGHT       = 20.0;
+  static constexpr double       DEFAULT_RES          = 0.05;
+  static constexpr unsigned int DEFAULT_N_GROW       = 1;
+  static constexpr unsigned int DEFAULT_THRESH_EMPTY = 1;
+
+  ros::Subscriber                  _subsCloud;
+  ros::Publisher                   _pubMap;
+  ros::Publisher                   _pubMapUpdate;
+
+  std::shared_ptr<const MapConfig> _config;  ///< latest configuration, only accessed by atomic load and store
+  std::shared_ptr<const MapConfig> _active;  ///< configuration of mapper, only used by cloud callback
+  std::string                      _tfFrameMap;
+  std::string                      _tfFrameOdom;
+
+  std::unique_ptr<tf::TransformListener> _listener;
+  std::unique_ptr<dynamic_reconfigure::Server<ohm_neg_obst::ReconfigureHeightMapperConfig> > _server;
+  NegObstMapper                    _mapper;
+
+  GridDeltaEncoder                 _encoder;    ///< changes of map for clients of the update topic
+  ohm_autonomy_msgs::GridUpdate    _mapUpdate;
+};
+
+#endif /* OHM_NEG_OBST_SRC_NEGOBSTMAPPERNODELET_H_ */
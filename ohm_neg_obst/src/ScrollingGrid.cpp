@@ -0,0 +1,175 @@
+/*
+ * ScrollingGrid.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "ScrollingGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace
+{
+/// Modulo with non negative result for negative cell coordinates
+inline unsigned int wrap(const int value, const unsigned int size)
+{
+  const int m = value % static_cast<int>(size);
+  return static_cast<unsigned int>(m < 0 ? m + static_cast<int>(size) : m);
+}
+
+const unsigned int MAX_DECAY_FRAMES = 256;
+
+/// Height range of cells without points, lowest above highest
+const float NO_HEIGHT = std::numeric_limits<float>::max();
+}
+
+ScrollingGrid::ScrollingGrid(void):
+  _width(0),
+  _height(0),
+  _res(0.05),
+  _originX(0),
+  _originY(0),
+  _placed(false),
+  _frame(0),
+  _hit(1.0f),
+  _miss(0.5f),
+  _max(5.0f),
+  _heightAge(10)
+{
+  this->setEvidence(_hit, _miss, 0.9f, _max);
+}
+
+void ScrollingGrid::resize(const unsigned int width, const unsigned int height, const double res)
+{
+  _width  = width;
+  _height = height;
+  _res    = res;
+  _placed = false;
+  _evidence.assign(_width * _height, 0.0f);
+  _stamp.assign(_width * _height, _frame);
+  _zMin.assign(_width * _height, NO_HEIGHT);
+  _zMax.assign(_width * _height, -NO_HEIGHT);
+  _heightStamp.assign(_width * _height, _frame);
+  this->updateOffsets();
+}
+
+void ScrollingGrid::setEvidence(const float hit, const float miss, const float decay, const float max)
+{
+  _hit  = hit;
+  _miss = miss;
+  _max  = max;
+
+  // evidence older than the table has decayed below a thousandth
+  _decay.clear();
+  float factor = 1.0f;
+  while((_decay.size() < MAX_DECAY_FRAMES) && (factor > 1e-3f))
+  {
+    _decay.push_back(factor);
+    factor *= std::min(std::max(decay, 0.0f), 1.0f);
+  }
+}
+
+void ScrollingGrid::scrollTo(const double x, const double y)
+{
+  if(!_width || !_height)
+    return;
+  const int originX = static_cast<int>(std::floor(x / _res)) - static_cast<int>(_width / 2);
+  const int originY = static_cast<int>(std::floor(y / _res)) - static_cast<int>(_height / 2);
+  const int dx = originX - _originX;
+  const int dy = originY - _originY;
+  if(_placed && !dx && !dy)
+    return;
+
+  if(!_placed || (static_cast<unsigned int>(std::abs(dx)) >= _width) || (static_cast<unsigned int>(std::abs(dy)) >= _height))
+  {
+    std::fill(_evidence.begin(), _evidence.end(), 0.0f);
+    std::fill(_stamp.begin(), _stamp.end(), _frame);
+    std::fill(_zMin.begin(), _zMin.end(), NO_HEIGHT);
+    std::fill(_zMax.begin(), _zMax.end(), -NO_HEIGHT);
+  }
+  else
+  {
+    // only columns and rows entering the window are cleared, all others stay where they are in storage
+    if(dx > 0)
+      this->clearColumns(_originX + _width, originX + _width);
+    else if(dx < 0)
+      this->clearColumns(originX, _originX);
+    if(dy > 0)
+      this->clearRows(_originY + _height, originY + _height);
+    else if(dy < 0)
+      this->clearRows(originY, _originY);
+  }
+
+  _originX = originX;
+  _originY = originY;
+  _placed  = true;
+  this->updateOffsets();
+}
+
+float ScrollingGrid::evidence(const unsigned int idx) const
+{
+  const unsigned int age = _frame - _stamp[idx];
+  return (age < _decay.size()) ? _evidence[idx] * _decay[age] : 0.0f;
+}
+
+void ScrollingGrid::update(const unsigned int idx, const float delta)
+{
+  _evidence[idx] = std::min(std::max(this->evidence(idx) + delta, -_max), _max);
+  _stamp[idx]    = _frame;
+}
+
+void ScrollingGrid::updateHeight(const unsigned int idx, const float zMin, const float zMax)
+{
+  if(!this->hasHeight(idx))
+  {
+    _zMin[idx]        = zMin;
+    _zMax[idx]        = zMax;
+    _heightStamp[idx] = _frame;
+    return;
+  }
+  _zMin[idx] = std::min(_zMin[idx], zMin);
+  _zMax[idx] = std::max(_zMax[idx], zMax);
+}
+
+void ScrollingGrid::clearCell(const unsigned int idx)
+{
+  _evidence[idx] = 0.0f;
+  _stamp[idx]    = _frame;
+  _zMin[idx]     = NO_HEIGHT;
+  _zMax[idx]     = -NO_HEIGHT;
+}
+
+void ScrollingGrid::clearColumns(const int from, const int to)
+{
+  for(int x = from; x < to; x++)
+  {
+    const unsigned int col = wrap(x, _width);
+    for(unsigned int row = 0; row < _height; row++)
+      this->clearCell(row * _width + col);
+  }
+}
+
+void ScrollingGrid::clearRows(const int from, const int to)
+{
+  for(int y = from; y < to; y++)
+  {
+    const unsigned int row = wrap(y, _height);
+    std::fill(_evidence.begin() + row * _width, _evidence.begin() + (row + 1) * _width, 0.0f);
+    std::fill(_stamp.begin() + row * _width, _stamp.begin() + (row + 1) * _width, _frame);
+    std::fill(_zMin.begin() + row * _width, _zMin.begin() + (row + 1) * _width, NO_HEIGHT);
+    std::fill(_zMax.begin() + row * _width, _zMax.begin() + (row + 1) * _width, -NO_HEIGHT);
+  }
+}
+
+void ScrollingGrid::updateOffsets(void)
+{
+  _rowStart.resize(_height);
+  _colOffset.resize(_width);
+  for(unsigned int row = 0; row < _height; row++)
+    _rowStart[row] = wrap(_originY + static_cast<int>(row), _height) * _width;
+  for(unsigned int col = 0; col < _width; col++)
+    _colOffset[col] = wrap(_originX + static_cast<int>(col), _width);
+}
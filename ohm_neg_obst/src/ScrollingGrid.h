@@ -0,0 +1,135 @@
+/*
+ * ScrollingGrid.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef OHM_NEG_OBST_SRC_SCROLLINGGRID_H_
+#define OHM_NEG_OBST_SRC_SCROLLINGGRID_H_
+
+#include <vector>
+
+/**
+ * @class ScrollingGrid
+ *
+ * Robot-centric grid in a fixed frame (odometry) with ground evidence per cell. Cells are stored in a ring buffer,
+ * so moving the window by whole cells only clears the rows and columns entering the window. Evidence decays per
+ * frame, the decay is applied lazily when a cell is touched again, so untouched cells cost nothing.
+ *
+ * Besides evidence, cells keep the lowest and highest point (2.5D elevation). Heights are collected over height age
+ * frames from the first observation of a cell, then collection starts over, so objects which moved away vanish.
+ */
+class ScrollingGrid
+{
+public:
+  ScrollingGrid(void);
+  virtual ~ScrollingGrid(void) { }
+
+  /**
+   * Set size of window and drop all evidence
+   * @param width       cells along x
+   * @param height      cells along y
+   * @param res         size of a cell in meters
+   */
+  void resize(const unsigned int width, const unsigned int height, const double res);
+
+  /**
+   * Set evidence model
+   * @param hit         evidence added by a cell observed as ground
+   * @param miss        evidence removed from a cell expected to be ground, but not observed
+   * @param decay       factor applied to evidence per frame
+   * @param max         evidence is clamped to [-max, max]
+   */
+  void setEvidence(const float hit, const float miss, const float decay, const float max);
+
+  /**
+   * Set number of frames heights of a cell are kept without being observed again
+   */
+  void setHeightAge(const unsigned int frames) { _heightAge = frames ? frames : 1; }
+
+  /**
+   * Move window, so position (x, y) in the fixed frame is in its center cell
+   * @param x
+   * @param y
+   */
+  void scrollTo(const double x, const double y);
+
+  /**
+   * Start a new frame, evidence of all cells decays by one step
+   */
+  void nextFrame(void) { _frame++; }
+
+  /**
+   * Index of storage for a cell of the window
+   * @param col         column in window, 0 is the column at originX()
+   * @param row         row in window, 0 is the row at originY()
+   */
+  unsigned int index(const unsigned int col, const unsigned int row) const
+  {
+    return _rowStart[row] + _colOffset[col];
+  }
+
+  void hit(const unsigned int idx)  { this->update(idx,  _hit); }
+  void miss(const unsigned int idx) { this->update(idx, -_miss); }
+
+  /**
+   * Extend height range of a cell by points observed in this frame
+   * @param idx         index of storage
+   * @param zMin        lowest point
+   * @param zMax        highest point
+   */
+  void updateHeight(const unsigned int idx, const float zMin, const float zMax);
+
+  /// Cell was observed within its current collection of heights
+  bool hasHeight(const unsigned int idx) const
+  {
+    return ((_frame - _heightStamp[idx]) < _heightAge) && (_zMin[idx] <= _zMax[idx]);
+  }
+  float heightMin(const unsigned int idx) const { return _zMin[idx]; }
+  float heightMax(const unsigned int idx) const { return _zMax[idx]; }
+
+  /**
+   * Decayed evidence of a cell
+   * @param idx         index of storage
+   */
+  float evidence(const unsigned int idx) const;
+
+  unsigned int width(void)  const { return _width; }
+  unsigned int height(void) const { return _height; }
+  double resolution(void)   const { return _res; }
+  /// Position of lower left corner of window in the fixed frame
+  double originX(void) const { return _originX * _res; }
+  double originY(void) const { return _originY * _res; }
+
+private:
+  void update(const unsigned int idx, const float delta);
+  void clearCell(const unsigned int idx);
+  void clearColumns(const int from, const int to);
+  void clearRows(const int from, const int to);
+  void updateOffsets(void);
+
+  unsigned int              _width;
+  unsigned int              _height;
+  double                    _res;
+  int                       _originX;      ///< lower left corner of window in cells of fixed frame
+  int                       _originY;
+  bool                      _placed;       ///< window was moved to the robot at least once
+
+  std::vector<float>        _evidence;     ///< ground evidence, positive for ground, negative for holes
+  std::vector<unsigned int> _stamp;        ///< frame of last update of a cell
+  std::vector<unsigned int> _rowStart;     ///< index of first cell of a window row in storage
+  std::vector<unsigned int> _colOffset;    ///< offset of a window column in storage row
+  std::vector<float>        _decay;        ///< decay after n frames, evidence is dropped after the last one
+  unsigned int              _frame;
+
+  float                     _hit;
+  float                     _miss;
+  float                     _max;
+
+  std::vector<float>        _zMin;         ///< lowest point of cell
+  std::vector<float>        _zMax;         ///< highest point of cell
+  std::vector<unsigned int> _heightStamp;  ///< frame collection of heights started
+  unsigned int              _heightAge;
+};
+
+#endif /* OHM_NEG_OBST_SRC_SCROLLINGGRID_H_ */
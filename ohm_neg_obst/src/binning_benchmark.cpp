@@ -0,0 +1,146 @@
+/*
+ * binning_benchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Bins a synthetic laser scanner cloud into the window of neg_obst_mapper with 1 to 8 threads, reports time per
+ * cloud and speedup, and checks the counts of every thread count against the single threaded ones. With -z the
+ * lowest and highest point per cell are binned and checked as well.
+ *
+ * usage: binning_benchmark [-p points] [-r repetitions] [-t max_threads] [-z]
+ */
+
+#include <ros/ros.h>
+
+#include "CloudBinner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace
+{
+/**
+ * Cloud of a rotating scanner with 32 rings above flat ground, with invalid points where no echo returned
+ */
+void makeCloud(sensor_msgs::PointCloud2* const cloud, const unsigned int points)
+{
+  const unsigned int rings = 32;
+  const char* names[4] = {"x", "y", "z", "intensity"};
+  cloud->fields.resize(4);
+  for(unsigned int i = 0; i < 4; i++)
+  {
+    cloud->fields[i].name     = names[i];
+    cloud->fields[i].offset   = i * sizeof(float);
+    cloud->fields[i].datatype = sensor_msgs::PointField::FLOAT32;
+    cloud->fields[i].count    = 1;
+  }
+  cloud->header.frame_id = "laser";
+  cloud->is_bigendian    = false;
+  cloud->is_dense        = false;
+  cloud->height          = rings;
+  cloud->width           = std::max(points / rings, 1u);
+  cloud->point_step      = 4 * sizeof(float);
+  cloud->row_step        = cloud->width * cloud->point_step;
+  cloud->data.resize(cloud->height * cloud->row_step);
+
+  std::srand(42);
+  for(unsigned int ring = 0; ring < cloud->height; ring++)
+  {
+    // rings hit the ground between 0.5 m and 12 m
+    const double range = 0.5 + 11.5 * ring / (rings - 1);
+    for(unsigned int col = 0; col < cloud->width; col++)
+    {
+      const double angle = 2.0 * M_PI * col / cloud->width;
+      const double noise = 0.02 * (std::rand() / static_cast<double>(RAND_MAX) - 0.5);
+      float p[4] = {static_cast<float>((range + noise) * std::cos(angle)),
+                    static_cast<float>((range + noise) * std::sin(angle)),
+                    static_cast<float>(-0.5 + noise), 1.0f};
+      if(std::rand() % 20 == 0)
+        p[0] = p[1] = p[2] = std::numeric_limits<float>::quiet_NaN();
+      std::memcpy(&cloud->data[ring * cloud->row_step + col * cloud->point_step], p, sizeof(p));
+    }
+  }
+}
+}
+
+int main(int argc, char** argv)
+{
+  ros::Time::init();
+
+  unsigned int points      = 65536;
+  unsigned int repetitions = 50;
+  unsigned int maxThreads  = 8;
+  bool         heights     = false;
+  for(int i = 1; i < argc; i++)
+  {
+    const std::string arg(argv[i]);
+    if(arg == "-p" && i + 1 < argc)      points      = std::max(std::atoi(argv[++i]), 32);
+    else if(arg == "-r" && i + 1 < argc) repetitions = std::max(std::atoi(argv[++i]), 1);
+    else if(arg == "-t" && i + 1 < argc) maxThreads  = std::max(std::atoi(argv[++i]), 1);
+    else if(arg == "-z")                 heights     = true;
+    else
+    {
+      std::printf("usage: binning_benchmark [-p points] [-r repetitions] [-t max_threads] [-z]\n");
+      return 1;
+    }
+  }
+
+  // window of neg_obst_mapper, 20 m at 5 cm
+  nav_msgs::MapMetaData info;
+  info.resolution        = 0.05;
+  info.width             = 399;
+  info.height            = 399;
+  info.origin.position.x = -10.0;
+  info.origin.position.y = -10.0;
+
+  sensor_msgs::PointCloud2 cloud;
+  makeCloud(&cloud, points);
+
+  // scanner 0.55 m above the robot, slightly pitched, robot moved away from the odometry origin
+  tf::Transform toBase(tf::createQuaternionFromRPY(0.0, 0.02, 0.0), tf::Vector3(0.1, 0.0, 0.55));
+  tf::Transform toGrid = tf::Transform(tf::createQuaternionFromYaw(0.3), tf::Vector3(1.2, -0.7, 0.0)) * toBase;
+  info.origin.position.x += 1.2;
+  info.origin.position.y -= 0.7;
+
+  std::vector<uint16_t> reference;
+  std::vector<float>    referenceMin;
+  std::vector<float>    referenceMax;
+  double                referenceMs = 0.0;
+  std::printf("%u points, %ux%u cells, %u repetitions\n", cloud.width * cloud.height, info.width, info.height, repetitions);
+  std::printf("%8s %10s %8s %8s %6s\n", "threads", "ms", "speedup", "cells", "equal");
+  for(unsigned int threads = 1; threads <= maxThreads; threads++)
+  {
+    CloudBinner binner;
+    binner.setThreads(threads);
+    binner.setHeightGate(true, -0.5, 0.5);
+    binner.setHeights(heights);
+    double best = -1.0;
+    for(unsigned int r = 0; r < repetitions; r++)
+    {
+      const ros::WallTime start = ros::WallTime::now();
+      binner.bin(cloud, toGrid, toBase, info);
+      const double ms = (ros::WallTime::now() - start).toSec() * 1000.0;
+      if(best < 0.0 || ms < best)
+        best = ms;
+    }
+    if(threads == 1)
+    {
+      reference    = binner.counts();
+      referenceMin = binner.heightMin();
+      referenceMax = binner.heightMax();
+      referenceMs  = best;
+    }
+    const bool equal = (binner.counts() == reference) &&
+                       (!heights || ((binner.heightMin() == referenceMin) && (binner.heightMax() == referenceMax)));
+    std::printf("%8u %8.3fms %7.2fx %8lu %6s\n", threads, best, referenceMs / best,
+                static_cast<unsigned long>(binner.cells().size()), equal ? "yes" : "NO");
+    if(!equal)
+      return 1;
+  }
+  return 0;
+}
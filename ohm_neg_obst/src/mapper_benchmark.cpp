@@ -0,0 +1,363 @@
+/*
+ * mapper_benchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Drives a synthetic scanner over terrain with holes in the floor, stairs down and ramps and runs NegObstMapper on
+ * every cloud. For every combination of map resolution, n_grow and thresh_empty it reports the mean time per stage,
+ * the peak memory the mapper allocated and its allocations per cloud. Densities of the terrain features are given per
+ * 100 square meters. With -z steps and drops are detected from heights instead.
+ *
+ * usage: mapper_benchmark [-p points] [-f frames] [-r repetitions] [-n holes] [-s stairs] [-a ramps]
+ *                         [-m res,..] [-g n_grow,..] [-e thresh_empty,..] [-z]
+ */
+
+#include <ros/ros.h>
+
+#include "NegObstMapper.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <malloc.h>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Count allocations and live bytes of whole program, binning may allocate from several threads. Blocks carry no
+ * header, so the nothrow variants of the library stay compatible, live bytes are taken from the allocator.
+ */
+namespace
+{
+std::atomic<unsigned long> g_allocations(0);
+std::atomic<long>          g_live(0);
+std::atomic<long>          g_peak(0);
+}
+
+void* operator new(std::size_t size)
+{
+  void* p = std::malloc(size ? size : 1);
+  if(!p)
+    throw std::bad_alloc();
+  g_allocations++;
+  const long live = (g_live += malloc_usable_size(p));
+  long peak = g_peak;
+  while((live > peak) && !g_peak.compare_exchange_weak(peak, live)) { }
+  return p;
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+  if(!p)
+    return;
+  g_live -= malloc_usable_size(p);
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  operator delete(p);
+}
+
+namespace
+{
+/**
+ * Heights of the terrain on a raster, features are cut into a flat floor at z = 0
+ */
+class Terrain
+{
+public:
+  Terrain(const double minX, const double minY, const double sizeX, const double sizeY, const double res):
+    _minX(minX), _minY(minY), _res(res),
+    _width(static_cast<unsigned int>(sizeX / res)), _height(static_cast<unsigned int>(sizeY / res)),
+    _z(_width * _height, 0.0f)
+  {
+  }
+
+  /// Round hole of depth 1 m
+  void addHole(const double x, const double y, const double radius)
+  {
+    for(unsigned int row = 0; row < _height; row++)
+      for(unsigned int col = 0; col < _width; col++)
+      {
+        const double dx = this->x(col) - x;
+        const double dy = this->y(row) - y;
+        if(dx * dx + dy * dy < radius * radius)
+          this->lower(col, row, -1.0);
+      }
+  }
+
+  /// Flight of 6 steps of 0.17 m down along x, 2 m wide, ending in a pit with a wall at its far end
+  void addStairs(const double x, const double y)
+  {
+    for(unsigned int row = 0; row < _height; row++)
+      for(unsigned int col = 0; col < _width; col++)
+      {
+        const double dx = this->x(col) - x;
+        if(std::fabs(this->y(row) - y) > 1.0 || dx < 0.0 || dx > 6 * 0.28 + 2.0)
+          continue;
+        const int step = std::min(static_cast<int>(dx / 0.28) + 1, 6);
+        this->lower(col, row, -0.17 * step);
+      }
+  }
+
+  /// Ramp of 15 degrees down along x and up again, 2 m wide, with 2 m of flat ground in between
+  void addRamp(const double x, const double y)
+  {
+    const double slope = std::tan(15.0 * M_PI / 180.0);
+    for(unsigned int row = 0; row < _height; row++)
+      for(unsigned int col = 0; col < _width; col++)
+      {
+        const double dx = this->x(col) - x;
+        if(std::fabs(this->y(row) - y) > 1.0 || dx < 0.0 || dx > 6.0)
+          continue;
+        const double depth = std::min(std::min(dx, 6.0 - dx), 2.0) * slope;
+        this->lower(col, row, -depth);
+      }
+  }
+
+  /// Height at a position, flat floor outside the raster
+  float z(const double x, const double y) const
+  {
+    const int col = static_cast<int>(std::floor((x - _minX) / _res));
+    const int row = static_cast<int>(std::floor((y - _minY) / _res));
+    if(col < 0 || row < 0 || col >= static_cast<int>(_width) || row >= static_cast<int>(_height))
+      return 0.0f;
+    return _z[row * _width + col];
+  }
+
+private:
+  double x(const unsigned int col) const { return _minX + (col + 0.5) * _res; }
+  double y(const unsigned int row) const { return _minY + (row + 0.5) * _res; }
+  void lower(const unsigned int col, const unsigned int row, const double z)
+  {
+    float& cell = _z[row * _width + col];
+    cell = std::min(cell, static_cast<float>(z));
+  }
+
+  double             _minX;
+  double             _minY;
+  double             _res;
+  unsigned int       _width;
+  unsigned int       _height;
+  std::vector<float> _z;
+};
+
+double uniform(const double min, const double max)
+{
+  return min + (max - min) * (std::rand() / static_cast<double>(RAND_MAX));
+}
+
+/**
+ * Cloud of a rotating scanner with 32 rings mounted 0.5 m above the floor at x, rays are marched through the terrain
+ */
+void makeCloud(sensor_msgs::PointCloud2* const cloud, const unsigned int points, const Terrain& terrain, const double x)
+{
+  const unsigned int rings    = 32;
+  const double       mount    = 0.5;
+  const double       maxRange = 15.0;
+  const double       stepSize = 0.03;
+  const char* names[4] = {"x", "y", "z", "intensity"};
+  cloud->fields.resize(4);
+  for(unsigned int i = 0; i < 4; i++)
+  {
+    cloud->fields[i].name     = names[i];
+    cloud->fields[i].offset   = i * sizeof(float);
+    cloud->fields[i].datatype = sensor_msgs::PointField::FLOAT32;
+    cloud->fields[i].count    = 1;
+  }
+  cloud->header.frame_id = "laser";
+  cloud->is_bigendian    = false;
+  cloud->is_dense        = false;
+  cloud->height          = rings;
+  cloud->width           = std::max(points / rings, 1u);
+  cloud->point_step      = 4 * sizeof(float);
+  cloud->row_step        = cloud->width * cloud->point_step;
+  cloud->data.resize(cloud->height * cloud->row_step);
+
+  for(unsigned int ring = 0; ring < cloud->height; ring++)
+  {
+    // on flat floor rings hit between 0.5 m and 12 m
+    const double elevation = std::atan2(mount, 0.5 + 11.5 * ring / (rings - 1));
+    for(unsigned int col = 0; col < cloud->width; col++)
+    {
+      const double azimuth = 2.0 * M_PI * col / cloud->width;
+      const tf::Vector3 dir(std::cos(elevation) * std::cos(azimuth), std::cos(elevation) * std::sin(azimuth),
+                            -std::sin(elevation));
+      float p[4] = {std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN(),
+                    std::numeric_limits<float>::quiet_NaN(), 1.0f};
+      for(double t = stepSize; t < maxRange; t += stepSize)
+      {
+        const tf::Vector3 hit = dir * t;
+        if(mount + hit.z() > terrain.z(x + hit.x(), hit.y()))
+          continue;
+        p[0] = hit.x();
+        p[1] = hit.y();
+        p[2] = hit.z();
+        break;
+      }
+      if(std::rand() % 20 == 0)
+        p[0] = p[1] = p[2] = std::numeric_limits<float>::quiet_NaN();
+      std::memcpy(&cloud->data[ring * cloud->row_step + col * cloud->point_step], p, sizeof(p));
+    }
+  }
+}
+
+template<typename T>
+bool parseList(const std::string& arg, std::vector<T>* const list)
+{
+  list->clear();
+  std::stringstream stream(arg);
+  std::string item;
+  while(std::getline(stream, item, ','))
+  {
+    std::stringstream value(item);
+    T v;
+    if(!(value >> v))
+      return false;
+    list->push_back(v);
+  }
+  return !list->empty();
+}
+}
+
+int main(int argc, char** argv)
+{
+  ros::Time::init();
+
+  unsigned int points      = 16384;
+  unsigned int frames      = 100;
+  unsigned int repetitions = 3;
+  double       holes       = 2.0;
+  double       stairs      = 0.5;
+  double       ramps       = 0.5;
+  bool         elevation   = false;
+  std::vector<double>       resolutions(1, 0.05);
+  std::vector<unsigned int> nGrows(1, 1);
+  std::vector<unsigned int> threshEmpties(1, 1);
+  bool valid = true;
+  for(int i = 1; i < argc && valid; i++)
+  {
+    const std::string arg(argv[i]);
+    if(arg == "-p" && i + 1 < argc)      points      = std::max(std::atoi(argv[++i]), 32);
+    else if(arg == "-f" && i + 1 < argc) frames      = std::max(std::atoi(argv[++i]), 1);
+    else if(arg == "-r" && i + 1 < argc) repetitions = std::max(std::atoi(argv[++i]), 1);
+    else if(arg == "-n" && i + 1 < argc) holes       = std::max(std::atof(argv[++i]), 0.0);
+    else if(arg == "-s" && i + 1 < argc) stairs      = std::max(std::atof(argv[++i]), 0.0);
+    else if(arg == "-a" && i + 1 < argc) ramps       = std::max(std::atof(argv[++i]), 0.0);
+    else if(arg == "-m" && i + 1 < argc) valid       = parseList(argv[++i], &resolutions);
+    else if(arg == "-g" && i + 1 < argc) valid       = parseList(argv[++i], &nGrows);
+    else if(arg == "-e" && i + 1 < argc) valid       = parseList(argv[++i], &threshEmpties);
+    else if(arg == "-z")                 elevation   = true;
+    else                                 valid       = false;
+  }
+  if(!valid)
+  {
+    std::printf("usage: mapper_benchmark [-p points] [-f frames] [-r repetitions] [-n holes] [-s stairs] [-a ramps]\n"
+                "                        [-m res,..] [-g n_grow,..] [-e thresh_empty,..] [-z]\n");
+    return 1;
+  }
+
+  // robot drives along x through the middle of the terrain, 0.1 m per cloud
+  const double minX  = -15.0;
+  const double minY  = -15.0;
+  const double sizeX = 30.0 + 0.1 * frames;
+  const double sizeY = 30.0;
+  const double area  = sizeX * sizeY / 100.0;
+  std::srand(42);
+  Terrain terrain(minX, minY, sizeX, sizeY, 0.02);
+  for(unsigned int i = 0; i < static_cast<unsigned int>(holes * area); i++)
+    terrain.addHole(uniform(minX, minX + sizeX), uniform(minY, minY + sizeY), uniform(0.2, 0.6));
+  for(unsigned int i = 0; i < static_cast<unsigned int>(stairs * area); i++)
+    terrain.addStairs(uniform(minX, minX + sizeX), uniform(minY, minY + sizeY));
+  for(unsigned int i = 0; i < static_cast<unsigned int>(ramps * area); i++)
+    terrain.addRamp(uniform(minX, minX + sizeX), uniform(minY, minY + sizeY));
+
+  std::vector<sensor_msgs::PointCloud2> clouds(frames);
+  std::vector<tf::Transform>            poses(frames);
+  for(unsigned int f = 0; f < frames; f++)
+  {
+    const double x = 0.1 * f;
+    makeCloud(&clouds[f], points, terrain, x);
+    clouds[f].header.stamp = ros::Time(1.0 + 0.1 * f);
+    poses[f] = tf::Transform(tf::createQuaternionFromYaw(0.0), tf::Vector3(x, 0.0, 0.5));
+  }
+  // scanner above the robot, points near the floor pass the height gate
+  const tf::Transform base(tf::createQuaternionFromYaw(0.0), tf::Vector3(0.0, 0.0, 0.5));
+
+  std::printf("%u points, %u frames, %u repetitions, %.1f holes, %.1f stairs, %.1f ramps per 100 m^2%s\n",
+              clouds[0].width * clouds[0].height, frames, repetitions, holes, stairs, ramps,
+              elevation ? ", elevation mode" : "");
+  std::printf("%6s %6s %6s %8s %8s %8s %8s %8s %8s %8s %9s %9s\n", "res", "n_grow", "thresh", "bin", "grow", "fuse",
+              "render", "footpr", "walls", "total", "peak MB", "allocs");
+  for(auto res : resolutions)
+  {
+    for(auto nGrow : nGrows)
+    {
+      for(auto threshEmpty : threshEmpties)
+      {
+        MapConfig config;
+        config.width       = 20.0;
+        config.height      = 20.0;
+        config.res         = res;
+        config.growing     = nGrow > 0;
+        config.nGrow       = nGrow;
+        config.threshEmpty = threshEmpty;
+        config.emptyRadius = 1;
+        config.stepHeight  = 0.1;
+        config.dropHeight  = 0.1;
+
+        NegObstMapper::StageTimes sum = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        unsigned int  updates     = 0;
+        unsigned long allocations = 0;
+        long          peak        = 0;
+        for(unsigned int r = 0; r < repetitions; r++)
+        {
+          const long start = g_live;
+          g_peak = start;
+          const unsigned long allocationsStart = g_allocations;
+          {
+            NegObstMapper mapper;
+            mapper.setFrame("odom");
+            mapper.setFusedFilter(true, -0.1, 0.1, 1);
+            mapper.setElevation(elevation, 10);
+            mapper.configure(config);
+            for(unsigned int f = 0; f < frames; f++)
+            {
+              NegObstMapper::StageTimes t;
+              if(!mapper.update(clouds[f], poses[f], base, &t))
+                continue;
+              sum.bin       += t.bin;
+              sum.grow      += t.grow;
+              sum.fuse      += t.fuse;
+              sum.render    += t.render;
+              sum.footprint += t.footprint;
+              sum.walls     += t.walls;
+              sum.total     += t.total;
+              updates++;
+            }
+          }
+          allocations += g_allocations - allocationsStart;
+          peak = std::max(peak, g_peak - start);
+        }
+        const double n = std::max(updates, 1u);
+        std::printf("%6.3f %6u %6u %6.3fms %6.3fms %6.3fms %6.3fms %6.3fms %6.3fms %6.3fms %9.2f %9.1f\n", res, nGrow,
+                    threshEmpty, sum.bin / n, sum.grow / n, sum.fuse / n, sum.render / n, sum.footprint / n,
+                    sum.walls / n, sum.total / n, peak / (1024.0 * 1024.0),
+                    allocations / static_cast<double>(repetitions * frames));
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,47 @@
+/*
+ * neg_map_relay.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Rebuilds the negative obstacle map from its update topic and publishes it as full grid, e.g. for rviz on an
+ * operator station. Only updates cross the network, the full grid is published locally.
+ */
+
+#include <ros/ros.h>
+#include <nav_msgs/OccupancyGrid.h>
+
+#include "ohm_neg_obst/GridDelta.h"
+
+#include <string>
+
+void callBackUpdate(const ohm_autonomy_msgs::GridUpdate::ConstPtr& update);
+
+static ros::Publisher   _pubMap;
+static GridDeltaDecoder _decoder;
+
+int main(int argc, char** argv)
+{
+  ros::init(argc, argv, "neg_map_relay");
+  std::string topicMapUpdate;
+  std::string topicMap;
+
+  ros::NodeHandle nh;
+  ros::NodeHandle prvNh("~");
+  prvNh.param<std::string>("topic_map_update", topicMapUpdate, "neg_map_update");
+  prvNh.param<std::string>("topic_map", topicMap, "neg_map_relayed");
+
+  ros::Subscriber subsUpdate = nh.subscribe(topicMapUpdate, 10, callBackUpdate);
+  _pubMap = nh.advertise<nav_msgs::OccupancyGrid>(topicMap, 1);
+
+  ros::spin();
+}
+
+void callBackUpdate(const ohm_autonomy_msgs::GridUpdate::ConstPtr& update)
+{
+  if(!_decoder.apply(*update))
+  {
+    ROS_WARN_THROTTLE(1.0, "neg_map_relay -> update %u lost or malformed, waiting for next keyframe", update->seq);
+    return;
+  }
+  _pubMap.publish(_decoder.grid());
+}